@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include "../include/libra/algorithm/binary_search.hpp"
+#include "detail/keys.hpp"
+#include "detail/perf_counters.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Runs search(first, last, key) over the sorted even keys [0, 2n), probing random keys
+// of which about half are present
+template <class Search>
+void run_search(benchmark::State& state, Search search) {
+	std::size_t n = state.range(0);
+	auto data = ascending_keys(n);
+	auto probes = random_keys(probe_count, n);
+	for (std::size_t i = 0; i != probe_count; ++i)
+		probes[i] += i & 1;
+	std::size_t i = 0;
+	perf_scope counters(state);
+	for (auto _ : state)
+		benchmark::DoNotOptimize(search(data.begin(), data.end(), probes[i++ % probe_count]));
+	state.SetItemsProcessed(state.iterations());
+}
+
+template <class Search>
+void register_search(const std::string& name, Search search) {
+	auto* bench = benchmark::RegisterBenchmark(name.c_str(), [search](benchmark::State& state) {
+		run_search(state, search);
+	});
+	for (auto n : cache_sizes(max_size))
+		bench->Arg(n);
+}
+
+using iterator = std::vector<int>::iterator;
+
+int main(int argc, char** argv) {
+	register_search("libra::lower_bound", [](iterator first, iterator last, int key) {
+		return libra::lower_bound(first, last, key);
+	});
+	register_search("std::lower_bound", [](iterator first, iterator last, int key) {
+		return std::lower_bound(first, last, key);
+	});
+	register_search("libra::upper_bound", [](iterator first, iterator last, int key) {
+		return libra::upper_bound(first, last, key);
+	});
+	register_search("std::upper_bound", [](iterator first, iterator last, int key) {
+		return std::upper_bound(first, last, key);
+	});
+	register_search("libra::equal_range", [](iterator first, iterator last, int key) {
+		return libra::equal_range(first, last, key);
+	});
+	register_search("std::equal_range", [](iterator first, iterator last, int key) {
+		return std::equal_range(first, last, key);
+	});
+	register_search("libra::binary_search", [](iterator first, iterator last, int key) {
+		return libra::binary_search(first, last, key);
+	});
+	register_search("std::binary_search", [](iterator first, iterator last, int key) {
+		return std::binary_search(first, last, key);
+	});
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
\ No newline at end of file
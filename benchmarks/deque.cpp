@@ -0,0 +1,220 @@
+#include <benchmark/benchmark.h>
+#include "../include/libra/container/deque.hpp"
+#include "detail/keys.hpp"
+#include "detail/cache.hpp"
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Element of Size bytes, ordered by its key
+template <std::size_t Size>
+struct element {
+	element(std::uint32_t k = 0) : key(k) {}
+
+	std::uint32_t key;
+	char payload[Size - sizeof(std::uint32_t)] = {};
+};
+
+template <>
+struct element<4> {
+	element(std::uint32_t k = 0) : key(k) {}
+
+	std::uint32_t key;
+};
+
+template <std::size_t Size>
+bool operator<(const element<Size>& lhs, const element<Size>& rhs) noexcept {
+	return lhs.key < rhs.key;
+}
+
+// Largest size whose elements fit in 1 GiB
+template <class T>
+constexpr std::int64_t size_limit = std::min<std::int64_t>(max_size, (std::int64_t(1) << 30) / sizeof(T));
+
+template <class C>
+constexpr bool is_vector_v = std::is_same_v<C, std::vector<typename C::value_type>>;
+
+// Benchmarks of one sequence type. std::vector only runs those not touching the front.
+template <class C>
+struct suite {
+
+	using value_type = typename C::value_type;
+
+	// A full container of size n. The deques are rotated by half their size first, so
+	// that their storage wraps around the end of the buffer.
+	static C build(std::size_t n) {
+		C c;
+		for (std::size_t i = 0; i != n; ++i)
+			c.push_back(value_type(static_cast<std::uint32_t>(i)));
+		if constexpr (!is_vector_v<C>) {
+			for (std::size_t i = 0; i != n / 2; ++i) {
+				c.push_back(c.front());
+				c.pop_front();
+			}
+		}
+		return c;
+	}
+
+	// Growth from empty, reallocating as it goes
+	static void push_back(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		for (auto _ : state) {
+			C c;
+			for (std::size_t i = 0; i != n; ++i)
+				c.push_back(value_type(static_cast<std::uint32_t>(i)));
+			benchmark::DoNotOptimize(c);
+		}
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+
+	static void push_front(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		for (auto _ : state) {
+			C c;
+			for (std::size_t i = 0; i != n; ++i)
+				c.push_front(value_type(static_cast<std::uint32_t>(i)));
+			benchmark::DoNotOptimize(c);
+		}
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+
+	// A work queue holding n elements: push at the back, pop at the front
+	static void queue(benchmark::State& state) {
+		C c = build(state.range(0));
+		std::uint32_t i = 0;
+		for (auto _ : state) {
+			c.push_back(value_type(i++));
+			c.pop_front();
+			benchmark::DoNotOptimize(c.back());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// The same queue running the other way
+	static void reverse_queue(benchmark::State& state) {
+		C c = build(state.range(0));
+		std::uint32_t i = 0;
+		for (auto _ : state) {
+			c.push_front(value_type(i++));
+			c.pop_back();
+			benchmark::DoNotOptimize(c.front());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	static void index_random(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		const C& c = cached<C>(n, build);
+		auto indices = random_keys(probe_count, n);
+		std::size_t i = 0;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(c[indices[i++ % probe_count] / 2].key);
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	static void traverse(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		const C& c = cached<C>(n, build);
+		for (auto _ : state) {
+			std::uint64_t sum = 0;
+			for (const auto& value : c)
+				sum += value.key;
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+
+	// One insertion and one erasure in the middle, keeping the size at n
+	static void middle_insert_erase(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		C c = build(n);
+		for (auto _ : state) {
+			auto it = c.insert(c.begin() + n / 2, value_type());
+			c.erase(it);
+			benchmark::DoNotOptimize(c.front());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	// Shrinking a container left half empty by pops at both ends
+	static void shrink_to_fit(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		for (auto _ : state) {
+			state.PauseTiming();
+			C c = build(n);
+			for (std::size_t i = 0; i != n / 4; ++i) {
+				c.pop_back();
+				if constexpr (!is_vector_v<C>)
+					c.pop_front();
+				else
+					c.pop_back();
+			}
+			state.ResumeTiming();
+			c.shrink_to_fit();
+			benchmark::DoNotOptimize(c);
+		}
+		state.SetItemsProcessed(state.iterations() * (n - n / 4 * 2));
+	}
+
+	static void sort(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		C input = build(n);
+		auto keys = random_keys(n, n);
+		std::size_t i = 0;
+		for (auto& value : input)
+			value.key = keys[i++];
+		for (auto _ : state) {
+			state.PauseTiming();
+			C c = input;
+			state.ResumeTiming();
+			std::sort(c.begin(), c.end());
+			benchmark::DoNotOptimize(c);
+		}
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+};
+
+template <class C>
+void register_suite(const std::string& name) {
+	using s = suite<C>;
+	auto add = [&name](const char* op, void (*fn)(benchmark::State&), std::int64_t limit) {
+		benchmark::RegisterBenchmark((name + "/" + op).c_str(), fn)
+			->RangeMultiplier(10)
+			->Range(10, limit);
+	};
+	constexpr std::int64_t limit = size_limit<typename C::value_type>;
+	add("push_back", s::push_back, limit);
+	add("index_random", s::index_random, limit);
+	add("traverse", s::traverse, limit);
+	add("middle_insert_erase", s::middle_insert_erase, std::min(limit, max_quadratic_size));
+	add("shrink_to_fit", s::shrink_to_fit, limit);
+	add("sort", s::sort, limit);
+	if constexpr (!is_vector_v<C>) {
+		add("push_front", s::push_front, limit);
+		add("queue", s::queue, limit);
+		add("reverse_queue", s::reverse_queue, limit);
+	}
+}
+
+template <std::size_t Size>
+void register_element_size() {
+	std::string size = "<" + std::to_string(Size) + ">";
+	register_suite<libra::deque<element<Size>>>("libra::deque" + size);
+	register_suite<std::deque<element<Size>>>("std::deque" + size);
+	register_suite<std::vector<element<Size>>>("std::vector" + size);
+}
+
+int main(int argc, char** argv) {
+	register_element_size<4>();
+	register_element_size<64>();
+	register_element_size<512>();
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <typeinfo>
+
+// Container shared by consecutive read-only benchmarks. Building one of 10^8 elements
+// dominates a run, and holding a single container at a time bounds the memory used.
+struct container_cache {
+	const std::type_info* type = nullptr;
+	std::size_t size = 0;
+	std::shared_ptr<void> data;
+};
+
+inline container_cache& shared_cache() {
+	static container_cache cache;
+	return cache;
+}
+
+// The container build(n) returns, built once for consecutive calls with the same C and n
+template <class C, class Build>
+const C& cached(std::size_t n, Build build) {
+	auto& cache = shared_cache();
+	if (cache.type != &typeid(C) || cache.size != n) {
+		cache.data.reset(); // release the previous container first
+		cache.data = std::make_shared<C>(build(n));
+		cache.type = &typeid(C);
+		cache.size = n;
+	}
+	return *static_cast<const C*>(cache.data.get());
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+
+#ifndef LIBRA_BENCHMARK_MAX_SIZE
+#define LIBRA_BENCHMARK_MAX_SIZE 100000000
+#endif
+
+// Largest container size, set through the LIBRA_BENCHMARK_MAX_SIZE cache variable
+constexpr std::int64_t max_size = LIBRA_BENCHMARK_MAX_SIZE;
+
+// Size limit of benchmarks whose cost grows quadratically on sorted arrays, such as
+// inserting or erasing elements one at a time in random order
+constexpr std::int64_t max_quadratic_size = std::min<std::int64_t>(max_size, 100000);
+
+// Fixed seed, so that consecutive runs measure the same sequences
+inline std::mt19937_64& engine() {
+	static std::mt19937_64 gen(0x5eed);
+	return gen;
+}
+
+// n even keys in random order, drawn from distinct values
+inline std::vector<int> random_keys(std::size_t n, std::size_t distinct) {
+	std::vector<int> keys(n);
+	std::uniform_int_distribution<int> dist(0, static_cast<int>(std::max<std::size_t>(distinct, 1) - 1));
+	for (auto& key : keys)
+		key = 2 * dist(engine());
+	return keys;
+}
+
+// The even keys 0, 2, ..., 2 * (n - 1)
+inline std::vector<int> ascending_keys(std::size_t n) {
+	std::vector<int> keys(n);
+	std::generate(keys.begin(), keys.end(), [k = 0]() mutable { return 2 * k++; });
+	return keys;
+}
+
+// Lookup keys cycled through by the lookup benchmarks. Even keys hit, odd keys miss.
+constexpr std::size_t probe_count = 1 << 12;
+
+inline std::vector<int> probe_keys(std::size_t n, bool hit) {
+	std::vector<int> keys = random_keys(probe_count, n);
+	if (!hit) {
+		for (auto& key : keys)
+			++key;
+	}
+	return keys;
+}
+
+// Sizes from within L1 to well past the last level cache for 4 byte keys, up to limit
+inline std::vector<std::int64_t> cache_sizes(std::int64_t limit) {
+	std::vector<std::int64_t> sizes;
+	for (std::int64_t n = 1 << 8; n <= std::min<std::int64_t>(limit, 1 << 24); n <<= 4)
+		sizes.push_back(n);
+	return sizes;
+}
\ No newline at end of file
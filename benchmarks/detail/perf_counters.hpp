@@ -0,0 +1,126 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#define LIBRA_HAS_PERF_EVENT 1
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#else
+#define LIBRA_HAS_PERF_EVENT 0
+#endif
+
+// Hardware event counters of the calling thread, read through Linux perf_event_open.
+// Counters that cannot be opened, because the platform lacks perf events or
+// kernel.perf_event_paranoid forbids them, are reported unavailable and read as 0.
+class perf_counters {
+public:
+
+	enum event { branch_misses, cache_misses, event_count };
+
+	static constexpr const char* names[event_count] = { "branch_misses", "cache_misses" };
+
+	perf_counters() {
+#if LIBRA_HAS_PERF_EVENT
+		const std::uint64_t configs[event_count] = { PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES };
+		for (int i = 0; i != event_count; ++i) {
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = configs[i];
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			m_fds[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+#endif
+	}
+
+	perf_counters(const perf_counters&) = delete;
+	perf_counters& operator=(const perf_counters&) = delete;
+
+	~perf_counters() {
+#if LIBRA_HAS_PERF_EVENT
+		for (int fd : m_fds) {
+			if (fd != -1)
+				close(fd);
+		}
+#endif
+	}
+
+	bool available(event e) const noexcept { return m_fds[e] != -1; }
+
+	void start() noexcept { control(true); }
+	void stop() noexcept { control(false); }
+
+	// Events counted while started, since construction
+	std::uint64_t read(event e) const noexcept {
+		std::uint64_t value = 0;
+#if LIBRA_HAS_PERF_EVENT
+		if (available(e) && ::read(m_fds[e], &value, sizeof(value)) != sizeof(value))
+			value = 0;
+#endif
+		return value;
+	}
+
+private:
+
+	void control(bool enable) noexcept {
+#if LIBRA_HAS_PERF_EVENT
+		for (int fd : m_fds) {
+			if (fd != -1)
+				ioctl(fd, enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+		}
+#else
+		(void)enable;
+#endif
+	}
+
+	int m_fds[event_count] = { -1, -1 };
+};
+
+// Counts hardware events over a benchmark's timed loop. Construct it right before the
+// loop; on destruction the available events are reported as per-iteration counters
+// next to the time. Setup inside the loop goes between pause() and resume(), which
+// stop the timer and the counters together.
+class perf_scope {
+public:
+
+	explicit perf_scope(benchmark::State& state)
+		: m_state(state) {
+		m_counters.start();
+	}
+
+	perf_scope(const perf_scope&) = delete;
+	perf_scope& operator=(const perf_scope&) = delete;
+
+	~perf_scope() {
+		m_counters.stop();
+		for (int i = 0; i != perf_counters::event_count; ++i) {
+			auto e = static_cast<perf_counters::event>(i);
+			if (m_counters.available(e)) {
+				m_state.counters[perf_counters::names[i]] = benchmark::Counter(
+					static_cast<double>(m_counters.read(e)), benchmark::Counter::kAvgIterations);
+			}
+		}
+	}
+
+	void pause() {
+		m_counters.stop();
+		m_state.PauseTiming();
+	}
+
+	void resume() {
+		m_state.ResumeTiming();
+		m_counters.start();
+	}
+
+private:
+
+	benchmark::State& m_state;
+	perf_counters m_counters;
+};
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include "../include/libra/algorithm/heap.hpp"
+#include "detail/keys.hpp"
+#include "detail/perf_counters.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+
+// Heap operations of one library, called with std::less<>
+struct libra_heap {
+	template <class RndIt>
+	static void make(RndIt first, RndIt last) { libra::make_heap(first, last, std::less<>{}); }
+	template <class RndIt>
+	static void push(RndIt first, RndIt last) { libra::push_heap(first, last, std::less<>{}); }
+	template <class RndIt>
+	static void pop(RndIt first, RndIt last) { libra::pop_heap(first, last, std::less<>{}); }
+};
+
+struct std_heap {
+	template <class RndIt>
+	static void make(RndIt first, RndIt last) { std::make_heap(first, last, std::less<>{}); }
+	template <class RndIt>
+	static void push(RndIt first, RndIt last) { std::push_heap(first, last, std::less<>{}); }
+	template <class RndIt>
+	static void pop(RndIt first, RndIt last) { std::pop_heap(first, last, std::less<>{}); }
+};
+
+// Heapifying n random keys
+template <class Heap>
+void make_heap(benchmark::State& state) {
+	std::size_t n = state.range(0);
+	auto keys = random_keys(n, n);
+	std::vector<int> data;
+	perf_scope counters(state);
+	for (auto _ : state) {
+		counters.pause();
+		data = keys;
+		counters.resume();
+		Heap::make(data.begin(), data.end());
+		benchmark::DoNotOptimize(data.data());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Pushing n random keys one at a time
+template <class Heap>
+void push_heap(benchmark::State& state) {
+	std::size_t n = state.range(0);
+	auto keys = random_keys(n, n);
+	std::vector<int> data;
+	data.reserve(n);
+	perf_scope counters(state);
+	for (auto _ : state) {
+		data.clear();
+		for (auto key : keys) {
+			data.push_back(key);
+			Heap::push(data.begin(), data.end());
+		}
+		benchmark::DoNotOptimize(data.data());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Popping a heap of n random keys until it is empty
+template <class Heap>
+void pop_heap(benchmark::State& state) {
+	std::size_t n = state.range(0);
+	auto heap = random_keys(n, n);
+	std_heap::make(heap.begin(), heap.end());
+	std::vector<int> data;
+	perf_scope counters(state);
+	for (auto _ : state) {
+		counters.pause();
+		data = heap;
+		counters.resume();
+		for (auto last = data.end(); last != data.begin(); --last)
+			Heap::pop(data.begin(), last);
+		benchmark::DoNotOptimize(data.data());
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <class Heap>
+void register_heap(const std::string& name) {
+	auto add = [&name](const char* op, void (*fn)(benchmark::State&), std::int64_t limit) {
+		auto* bench = benchmark::RegisterBenchmark((name + "::" + op).c_str(), fn);
+		for (auto n : cache_sizes(limit))
+			bench->Arg(n);
+	};
+	add("make_heap", make_heap<Heap>, max_size);
+	add("push_heap", push_heap<Heap>, max_size);
+	add("pop_heap", pop_heap<Heap>, max_size);
+}
+
+int main(int argc, char** argv) {
+	register_heap<libra_heap>("libra");
+	register_heap<std_heap>("std");
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include <benchmark/benchmark.h>
+#include "../include/libra/container/ordered_set.hpp"
+#include "../include/libra/container/ordered_map.hpp"
+#include "../include/libra/container/ordered_multiset.hpp"
+#include "../include/libra/container/ordered_multimap.hpp"
+#include "detail/keys.hpp"
+#include "detail/cache.hpp"
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#if __has_include(<flat_set>)
+#include <flat_set>
+#endif
+#if __has_include(<flat_map>)
+#include <flat_map>
+#endif
+
+// Builds a value of C from an int key, mapping keys to themselves
+template <class C>
+typename C::value_type make_value(int key) {
+	if constexpr (std::is_same_v<typename C::key_type, typename C::value_type>)
+		return key;
+	else
+		return typename C::value_type(key, key);
+}
+
+// Benchmarks of one container type. Containers allowing duplicates hold every key four
+// times. Sizes are passed as the benchmark's range, and every benchmark reports the
+// number of elements processed.
+template <class C, bool Duplicates>
+struct suite {
+
+	static constexpr std::size_t repeats = Duplicates ? 4 : 1;
+
+	static std::size_t distinct(std::size_t n) {
+		return (n + repeats - 1) / repeats;
+	}
+
+	static std::vector<int> sorted_keys(std::size_t n) {
+		std::vector<int> keys(n);
+		for (std::size_t i = 0; i != n; ++i)
+			keys[i] = static_cast<int>(2 * (i / repeats));
+		return keys;
+	}
+
+	static C build(std::size_t n) {
+		C c;
+		for (auto key : sorted_keys(n))
+			c.insert(c.end(), make_value<C>(key));
+		return c;
+	}
+
+	// Construction from an unsorted range
+	static void construct(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		std::vector<typename C::value_type> values;
+		for (auto key : random_keys(n, distinct(n)))
+			values.push_back(make_value<C>(key));
+		for (auto _ : state) {
+			C c(values.begin(), values.end());
+			benchmark::DoNotOptimize(c);
+		}
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+
+	template <class Keys>
+	static void insert_each(benchmark::State& state, const Keys& keys, bool hinted) {
+		for (auto _ : state) {
+			C c;
+			if (hinted) {
+				for (auto key : keys)
+					c.insert(c.end(), make_value<C>(key));
+			}
+			else {
+				for (auto key : keys)
+					c.insert(make_value<C>(key));
+			}
+			benchmark::DoNotOptimize(c);
+		}
+		state.SetItemsProcessed(state.iterations() * keys.size());
+	}
+
+	static void insert_random(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		insert_each(state, random_keys(n, distinct(n)), false);
+	}
+
+	static void insert_ascending(benchmark::State& state) {
+		insert_each(state, sorted_keys(state.range(0)), false);
+	}
+
+	// Ascending insertion hinted with end()
+	static void insert_hinted(benchmark::State& state) {
+		insert_each(state, sorted_keys(state.range(0)), true);
+	}
+
+	template <bool Hit>
+	static void find(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		const C& c = cached<C>(n, build);
+		auto probes = probe_keys(distinct(n), Hit);
+		std::size_t i = 0;
+		for (auto _ : state)
+			benchmark::DoNotOptimize(c.find(probes[i++ % probe_count]));
+		state.SetItemsProcessed(state.iterations());
+	}
+
+	static void iterate(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		const C& c = cached<C>(n, build);
+		for (auto _ : state) {
+			std::int64_t sum = 0;
+			for (const auto& value : c) {
+				if constexpr (std::is_same_v<typename C::key_type, typename C::value_type>)
+					sum += value;
+				else
+					sum += value.first;
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+
+	// Erasure of every key in random order
+	static void erase(benchmark::State& state) {
+		std::size_t n = state.range(0);
+		auto keys = sorted_keys(n);
+		keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+		std::shuffle(keys.begin(), keys.end(), engine());
+		for (auto _ : state) {
+			state.PauseTiming();
+			C c = build(n);
+			state.ResumeTiming();
+			for (auto key : keys)
+				c.erase(key);
+			benchmark::DoNotOptimize(c);
+		}
+		state.SetItemsProcessed(state.iterations() * n);
+	}
+};
+
+template <class C, bool Duplicates = false>
+void register_suite(const std::string& name) {
+	using s = suite<C, Duplicates>;
+	auto add = [&name](const char* op, void (*fn)(benchmark::State&), std::int64_t limit) {
+		benchmark::RegisterBenchmark((name + "/" + op).c_str(), fn)
+			->RangeMultiplier(10)
+			->Range(10, limit);
+	};
+	add("construct", s::construct, max_size);
+	add("insert_random", s::insert_random, max_quadratic_size);
+	add("insert_ascending", s::insert_ascending, max_size);
+	add("insert_hinted", s::insert_hinted, max_size);
+	add("find_hit", s::template find<true>, max_size);
+	add("find_miss", s::template find<false>, max_size);
+	add("iterate", s::iterate, max_size);
+	add("erase", s::erase, max_quadratic_size);
+}
+
+int main(int argc, char** argv) {
+	register_suite<libra::ordered_set<int>>("libra::ordered_set");
+	register_suite<std::set<int>>("std::set");
+#if defined(__cpp_lib_flat_set)
+	register_suite<std::flat_set<int>>("std::flat_set");
+#endif
+
+	register_suite<libra::ordered_map<int, int>>("libra::ordered_map");
+	register_suite<std::map<int, int>>("std::map");
+#if defined(__cpp_lib_flat_map)
+	register_suite<std::flat_map<int, int>>("std::flat_map");
+#endif
+
+	register_suite<libra::ordered_multiset<int>, true>("libra::ordered_multiset");
+	register_suite<std::multiset<int>, true>("std::multiset");
+#if defined(__cpp_lib_flat_set)
+	register_suite<std::flat_multiset<int>, true>("std::flat_multiset");
+#endif
+
+	register_suite<libra::ordered_multimap<int, int>, true>("libra::ordered_multimap");
+	register_suite<std::multimap<int, int>, true>("std::multimap");
+#if defined(__cpp_lib_flat_map)
+	register_suite<std::flat_multimap<int, int>, true>("std::flat_multimap");
+#endif
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	return 0;
+}
\ No newline at end of file
@@ -1,21 +1,68 @@
 #pragma once
 
+#include <memory>
+#include <cstddef>
 #include <iterator>
+#include <algorithm>
 #include <functional>
+#include <type_traits>
+#include "../detail/intrinsics.hpp"
+#include "../detail/simd_search.hpp"
 #include "../detail/extract_key.hpp"
 
 namespace libra {
 	namespace detail {
+
+		// The branchless kernel pays off when probing is cheap and memory bound:
+		// random access iterators over real elements with scalar keys.
+		template <class RndIt, class Key, class ExtractKey>
+		constexpr bool use_branchless_search_v =
+			std::is_same_v<typename std::iterator_traits<RndIt>::iterator_category, std::random_access_iterator_tag>
+			&& std::is_lvalue_reference_v<typename std::iterator_traits<RndIt>::reference>
+			&& std::is_scalar_v<Key>
+			&& std::is_scalar_v<std::decay_t<decltype(std::declval<ExtractKey>()(*std::declval<RndIt>()))>>;
+
+		// Fixed trip count search whose only data dependent step is a conditional move.
+		// Both candidate probes of the next level are prefetched while the current one resolves.
+		template <class RndIt, class Predicate>
+		RndIt branchless_partition_point(RndIt first, RndIt last, Predicate pred)
+		{
+			using diff_t = typename std::iterator_traits<RndIt>::difference_type;
+			diff_t len = last - first;
+			if (len == 0)
+				return first;
+			while (len > 1) {
+				diff_t half = len / 2;
+				diff_t next_half = (len - half) / 2;
+				detail::prefetch(std::addressof(first[next_half]));
+				detail::prefetch(std::addressof(first[half + next_half]));
+				first += pred(first[half]) ? half : 0;
+				len -= half;
+			}
+			return first + (pred(*first) ? 1 : 0);
+		}
+
 		template <class RndIt, class Key, class Compare, class ExtractKey>
 		constexpr RndIt lower_bound(RndIt first, RndIt last, const Key& key, Compare comp, ExtractKey extract)
 		{
+			if constexpr (use_simd_search_v<RndIt, Key, Compare, ExtractKey>) {
+				if (!detail::is_constant_evaluated() && first != last) {
+					auto data = std::addressof(*first);
+					return first + (detail::simd_bound<false>(data, data + (last - first), key) - data);
+				}
+			}
+			else if constexpr (use_branchless_search_v<RndIt, Key, ExtractKey>) {
+				if (!detail::is_constant_evaluated()) {
+					return detail::branchless_partition_point(first, last, [&](const auto& value) {
+						return comp(extract(value), key);
+					});
+				}
+			}
 			using diff_t = typename std::iterator_traits<RndIt>::difference_type;
 			diff_t len = last - first;
-			diff_t step;
-			RndIt mid;
 			while (len > 0) {
-				mid = first;
-				step = len / 2;
+				RndIt mid = first;
+				diff_t step = len / 2;
 				mid += step;
 				if (comp(extract(*mid), key)) {
 					first = ++mid;
@@ -30,13 +77,24 @@ namespace libra {
 		template <class RndIt, class Key, class Compare, class ExtractKey>
 		constexpr RndIt upper_bound(RndIt first, RndIt last, const Key& key, Compare comp, ExtractKey extract)
 		{
+			if constexpr (use_simd_search_v<RndIt, Key, Compare, ExtractKey>) {
+				if (!detail::is_constant_evaluated() && first != last) {
+					auto data = std::addressof(*first);
+					return first + (detail::simd_bound<true>(data, data + (last - first), key) - data);
+				}
+			}
+			else if constexpr (use_branchless_search_v<RndIt, Key, ExtractKey>) {
+				if (!detail::is_constant_evaluated()) {
+					return detail::branchless_partition_point(first, last, [&](const auto& value) {
+						return !comp(key, extract(value));
+					});
+				}
+			}
 			using diff_t = typename std::iterator_traits<RndIt>::difference_type;
 			diff_t len = last - first;
-			diff_t step;
-			RndIt mid;
 			while (len > 0) {
-				mid = first;
-				step = len / 2;
+				RndIt mid = first;
+				diff_t step = len / 2;
 				mid += step;
 				if (!comp(key, extract(*mid))) {
 					first = ++mid;
@@ -47,6 +105,128 @@ namespace libra {
 			}
 			return first;
 		}
+
+		// Number of searches the batched bounds advance in lockstep
+		constexpr std::size_t batch_width = 16;
+
+		// Runs one branchless search per key in lockstep with the other keys of its group, so
+		// the cache misses of the whole group overlap. The next probe of every search is
+		// prefetched as soon as its position is known. When the keys arrive sorted, each
+		// group starts where the previous group's last search ended.
+		template <bool Upper, class RndIt, class FwdIt, class OutIt, class Compare, class ExtractKey, class Finish>
+		OutIt bound_many(RndIt first, RndIt last, FwdIt keys_first, FwdIt keys_last, OutIt out, Compare comp, ExtractKey extract, Finish finish)
+		{
+			using diff_t = typename std::iterator_traits<RndIt>::difference_type;
+			constexpr bool can_prefetch = std::is_lvalue_reference_v<typename std::iterator_traits<RndIt>::reference>;
+			auto before = [&](const auto& value, const auto& key) {
+				if constexpr (Upper)
+					return !comp(key, extract(value));
+				else
+					return comp(extract(value), key);
+			};
+			const bool sorted_keys = std::is_sorted(keys_first, keys_last, comp);
+			RndIt base[batch_width];
+			FwdIt keys[batch_width];
+			while (keys_first != keys_last) {
+				std::size_t n = 0;
+				for (; n != batch_width && keys_first != keys_last; ++n, ++keys_first) {
+					base[n] = first;
+					keys[n] = keys_first;
+				}
+				diff_t len = last - first;
+				if (len != 0) {
+					while (len > 1) {
+						diff_t half = len / 2;
+						diff_t next_half = (len - half) / 2;
+						for (std::size_t i = 0; i != n; ++i) {
+							base[i] += before(base[i][half], *keys[i]) ? half : 0;
+							if constexpr (can_prefetch)
+								detail::prefetch(std::addressof(base[i][next_half]));
+						}
+						len -= half;
+					}
+					for (std::size_t i = 0; i != n; ++i)
+						base[i] += before(*base[i], *keys[i]) ? 1 : 0;
+				}
+				for (std::size_t i = 0; i != n; ++i)
+					*out++ = finish(base[i], *keys[i]);
+				if (sorted_keys)
+					first = base[n - 1];
+			}
+			return out;
+		}
+
+		struct keep_bound {
+			template <class It, class Key>
+			It operator()(It it, const Key&) const {
+				return it;
+			}
+		};
+
+		// Gallops from hint towards the bound in steps of 1, 2, 4, ... and binary searches the
+		// last step, which takes O(log d) probes where d is the distance from hint to the bound.
+		template <bool Upper, class RndIt, class Key, class Compare, class ExtractKey>
+		constexpr RndIt exponential_bound(RndIt first, RndIt hint, RndIt last, const Key& key, Compare comp, ExtractKey extract)
+		{
+			using diff_t = typename std::iterator_traits<RndIt>::difference_type;
+			auto before = [&](const auto& value) {
+				if constexpr (Upper)
+					return !comp(key, extract(value));
+				else
+					return comp(extract(value), key);
+			};
+			auto bound = [&](RndIt lo, RndIt hi) {
+				if constexpr (Upper)
+					return detail::upper_bound(lo, hi, key, comp, extract);
+				else
+					return detail::lower_bound(lo, hi, key, comp, extract);
+			};
+			if (hint != last && before(*hint)) {
+				diff_t room = last - hint;
+				diff_t step = 1;
+				while (step < room && before(hint[step]))
+					step *= 2;
+				return bound(hint + step / 2 + 1, hint + std::min(step, room));
+			}
+			diff_t room = hint - first;
+			diff_t step = 1;
+			while (step <= room && !before(*(hint - step)))
+				step *= 2;
+			return bound(step <= room ? hint - step + 1 : first, hint - step / 2);
+		}
+
+		// Narrows the range until its midpoint is equivalent to key. The lower bound is then
+		// searched for below the midpoint, and the upper bound galloped to from it.
+		template <class RndIt, class Key, class Compare, class ExtractKey>
+		constexpr std::pair<RndIt, RndIt> equal_range(RndIt first, RndIt last, const Key& key, Compare comp, ExtractKey extract)
+		{
+			using diff_t = typename std::iterator_traits<RndIt>::difference_type;
+			diff_t len = last - first;
+			while (len > 0) {
+				diff_t half = len / 2;
+				RndIt mid = first + half;
+				if (comp(extract(*mid), key)) {
+					first = mid + 1;
+					len -= half + 1;
+				}
+				else if (comp(key, extract(*mid))) {
+					len = half;
+				}
+				else {
+					return {
+						detail::lower_bound(first, mid, key, comp, extract),
+						detail::exponential_bound<true>(mid, mid, first + len, key, comp, extract)
+					};
+				}
+			}
+			return { first, first };
+		}
+	}
+
+	template <class RndIt, class Key, class Compare>
+	constexpr RndIt lower_bound(RndIt first, RndIt last, const Key& key, Compare comp)
+	{
+		return detail::lower_bound(first, last, key, comp, detail::identity<Key>{});
 	}
 
 	template <class RndIt, class Key>
@@ -56,9 +236,9 @@ namespace libra {
 	}
 
 	template <class RndIt, class Key, class Compare>
-	constexpr RndIt lower_bound(RndIt first, RndIt last, const Key& key, Compare comp)
+	constexpr RndIt upper_bound(RndIt first, RndIt last, const Key& key, Compare comp)
 	{
-		return detail::lower_bound(first, last, key, comp, detail::identity<Key>{});
+		return detail::upper_bound(first, last, key, comp, detail::identity<Key>{});
 	}
 
 	template <class RndIt, class Key>
@@ -67,16 +247,47 @@ namespace libra {
 		return libra::upper_bound(first, last, key, std::less<>{});
 	}
 
+	// Writes libra::lower_bound(first, last, key, comp) for every key of [keys_first, keys_last) to out.
+	// The searches run interleaved, which hides most of the memory latency of large ranges.
+	template <class RndIt, class FwdIt, class OutIt, class Compare>
+	OutIt lower_bound_many(RndIt first, RndIt last, FwdIt keys_first, FwdIt keys_last, OutIt out, Compare comp)
+	{
+		using key_t = typename std::iterator_traits<FwdIt>::value_type;
+		return detail::bound_many<false>(first, last, keys_first, keys_last, out, comp, detail::identity<key_t>{}, detail::keep_bound{});
+	}
+
+	template <class RndIt, class FwdIt, class OutIt>
+	OutIt lower_bound_many(RndIt first, RndIt last, FwdIt keys_first, FwdIt keys_last, OutIt out)
+	{
+		return libra::lower_bound_many(first, last, keys_first, keys_last, out, std::less<>{});
+	}
+
+	// Writes libra::upper_bound(first, last, key, comp) for every key of [keys_first, keys_last) to out
+	template <class RndIt, class FwdIt, class OutIt, class Compare>
+	OutIt upper_bound_many(RndIt first, RndIt last, FwdIt keys_first, FwdIt keys_last, OutIt out, Compare comp)
+	{
+		using key_t = typename std::iterator_traits<FwdIt>::value_type;
+		return detail::bound_many<true>(first, last, keys_first, keys_last, out, comp, detail::identity<key_t>{}, detail::keep_bound{});
+	}
+
+	template <class RndIt, class FwdIt, class OutIt>
+	OutIt upper_bound_many(RndIt first, RndIt last, FwdIt keys_first, FwdIt keys_last, OutIt out)
+	{
+		return libra::upper_bound_many(first, last, keys_first, keys_last, out, std::less<>{});
+	}
+
+	// Returns libra::lower_bound(first, last, key, comp), searching outward from hint.
+	// Cheaper than a full binary search when the bound is known to lie close to hint.
 	template <class RndIt, class Key, class Compare>
-	constexpr RndIt upper_bound(RndIt first, RndIt last, const Key& key, Compare comp)
+	constexpr RndIt exponential_search(RndIt first, RndIt last, RndIt hint, const Key& key, Compare comp)
 	{
-		return detail::upper_bound(first, last, key, comp, detail::identity<Key>{});
+		return detail::exponential_bound<false>(first, hint, last, key, comp, detail::identity<Key>{});
 	}
 
 	template <class RndIt, class Key>
-	constexpr bool binary_search(RndIt first, RndIt last, const Key& key)
+	constexpr RndIt exponential_search(RndIt first, RndIt last, RndIt hint, const Key& key)
 	{
-		return libra::binary_search(first, last, key, std::less<>{});
+		return libra::exponential_search(first, last, hint, key, std::less<>{});
 	}
 
 	template <class RndIt, class Key, class Compare>
@@ -87,15 +298,21 @@ namespace libra {
 	}
 
 	template <class RndIt, class Key>
-	constexpr std::pair<RndIt, RndIt> equal_range(RndIt first, RndIt last, const Key& key)
+	constexpr bool binary_search(RndIt first, RndIt last, const Key& key)
 	{
-		return libra::equal_range(first, last, key, std::less<>{});
+		return libra::binary_search(first, last, key, std::less<>{});
 	}
 
 	template <class RndIt, class Key, class Compare>
 	constexpr std::pair<RndIt, RndIt> equal_range(RndIt first, RndIt last, const Key& key, Compare comp)
 	{
-		return { libra::lower_bound(first, last, key, comp), libra::upper_bound(first, last, key, comp) };
+		return detail::equal_range(first, last, key, comp, detail::identity<Key>{});
+	}
+
+	template <class RndIt, class Key>
+	constexpr std::pair<RndIt, RndIt> equal_range(RndIt first, RndIt last, const Key& key)
+	{
+		return libra::equal_range(first, last, key, std::less<>{});
 	}
 
 }
\ No newline at end of file
@@ -1,37 +1,82 @@
 #pragma once
 
 #include <cassert>
+#include <utility>
 #include <iterator>
 #include <functional>
 
 namespace libra {
 	namespace detail {
 		template <class RndIt> using rnd_acc_diff_t = typename std::iterator_traits<RndIt>::difference_type;
+		template <class RndIt> using rnd_acc_value_t = typename std::iterator_traits<RndIt>::value_type;
 
+		// Moves the element at idx up past every ancestor ordered before it
 		template <class RndIt, class Compare>
 		constexpr void sift_up_heap(RndIt data, rnd_acc_diff_t<RndIt> idx, Compare comp)
 		{
-			while (idx > 0 && comp(data[(idx - 1) / 2], data[idx])) {
-				std::swap(data[(idx - 1) / 2], data[idx]);
-				idx = (idx - 1) / 2;
+			rnd_acc_value_t<RndIt> value = std::move(data[idx]);
+			while (idx > 0) {
+				auto parent = (idx - 1) / 2;
+				if (!comp(data[parent], value))
+					break;
+				data[idx] = std::move(data[parent]);
+				idx = parent;
 			}
+			data[idx] = std::move(value);
 		}
 
+		// Moves the element at idx down past every descendant ordered after it
 		template <class RndIt, class Compare>
-		constexpr void sift_down_heap(RndIt data, rnd_acc_diff_t<RndIt> parent, rnd_acc_diff_t<RndIt> len, Compare comp)
+		constexpr void sift_down_heap(RndIt data, rnd_acc_diff_t<RndIt> idx, rnd_acc_diff_t<RndIt> len, Compare comp)
 		{
-			while (2 * parent <= len) {
-				auto child = 2 * parent;
-				if (child < len && comp(data[child - 1], data[child]))
+			rnd_acc_value_t<RndIt> value = std::move(data[idx]);
+			for (auto child = 2 * idx + 1; child < len; child = 2 * idx + 1) {
+				if (child + 1 < len && comp(data[child], data[child + 1]))
 					++child;
-				if (comp(data[parent - 1], data[child - 1])) {
-					std::swap(data[parent - 1], data[child - 1]);
-					parent = child;
-				}
-				else
+				if (!comp(value, data[child]))
 					break;
+				data[idx] = std::move(data[child]);
+				idx = child;
 			}
+			data[idx] = std::move(value);
 		}
+
+		// Fills the hole at idx with value. The hole first descends to a leaf through the
+		// larger children, then value sifts up from there. Values placed this way usually
+		// belong near the bottom, so this takes about half the comparisons of sift_down_heap.
+		template <class RndIt, class Compare>
+		constexpr void fill_heap_hole(RndIt data, rnd_acc_diff_t<RndIt> idx, rnd_acc_diff_t<RndIt> len, rnd_acc_value_t<RndIt> value, Compare comp)
+		{
+			auto top = idx;
+			auto child = 2 * idx + 2;
+			for (; child < len; child = 2 * idx + 2) {
+				if (comp(data[child], data[child - 1]))
+					--child;
+				data[idx] = std::move(data[child]);
+				idx = child;
+			}
+			if (child == len) {
+				data[idx] = std::move(data[child - 1]);
+				idx = child - 1;
+			}
+			while (idx > top) {
+				auto parent = (idx - 1) / 2;
+				if (!comp(data[parent], value))
+					break;
+				data[idx] = std::move(data[parent]);
+				idx = parent;
+			}
+			data[idx] = std::move(value);
+		}
+	}
+
+	template <class RndIt, class Compare>
+	constexpr void make_heap(RndIt first, RndIt last, Compare comp)
+	{
+		assert(first <= last);
+		auto len = last - first;
+		for (auto i = len / 2; i != 0; --i)
+			detail::fill_heap_hole(first, i - 1, len, std::move(first[i - 1]), comp);
 	}
 
 	template <class RndIt>
@@ -41,14 +86,10 @@ namespace libra {
 	}
 
 	template <class RndIt, class Compare>
-	constexpr void make_heap(RndIt first, RndIt last, Compare comp)
+	constexpr void push_heap(RndIt first, RndIt last, Compare comp)
 	{
-		assert(first <= last);
-		auto len = last - first;
-		auto mid = len / 2;
-		RndIt data = first;
-		for (auto i = mid; i != 0; --i)
-			detail::sift_down_heap(first, i, len, comp);
+		assert(first < last);
+		detail::sift_up_heap(first, last - first - 1, comp);
 	}
 
 	template <class RndIt>
@@ -57,13 +98,17 @@ namespace libra {
 		libra::push_heap(first, last, std::less<>{});
 	}
 
+	// Moves the largest element to the back and restores the heap on the rest. O(log n).
 	template <class RndIt, class Compare>
-	constexpr void push_heap(RndIt first, RndIt last, Compare comp)
+	constexpr void pop_heap(RndIt first, RndIt last, Compare comp)
 	{
 		assert(first < last);
-		RndIt data = first;
 		auto len = last - first;
-		detail::sift_up_heap(first, len - 1, comp);
+		if (len == 1)
+			return;
+		detail::rnd_acc_value_t<RndIt> value = std::move(first[len - 1]);
+		first[len - 1] = std::move(first[0]);
+		detail::fill_heap_hole(first, 0, len - 1, std::move(value), comp);
 	}
 
 	template <class RndIt>
@@ -72,13 +117,68 @@ namespace libra {
 		libra::pop_heap(first, last, std::less<>{});
 	}
 
+	// Sorts a heap in ascending order
 	template <class RndIt, class Compare>
-	constexpr void pop_heap(RndIt first, RndIt last, Compare comp)
+	constexpr void sort_heap(RndIt first, RndIt last, Compare comp)
 	{
-		assert(first < last);
-		if (first == std::prev(last))
-			return;
-		std::iter_swap(first, std::prev(last));
-		libra::make_heap(first, std::prev(last), comp);
+		assert(first <= last);
+		for (; last - first > 1; --last)
+			libra::pop_heap(first, last, comp);
+	}
+
+	template <class RndIt>
+	constexpr void sort_heap(RndIt first, RndIt last)
+	{
+		libra::sort_heap(first, last, std::less<>{});
+	}
+
+	// Returns the end of the longest prefix of [first, last) that is a heap
+	template <class RndIt, class Compare>
+	constexpr RndIt is_heap_until(RndIt first, RndIt last, Compare comp)
+	{
+		assert(first <= last);
+		auto len = last - first;
+		for (decltype(len) child = 1; child < len; ++child) {
+			if (comp(first[(child - 1) / 2], first[child]))
+				return first + child;
+		}
+		return last;
+	}
+
+	template <class RndIt>
+	constexpr RndIt is_heap_until(RndIt first, RndIt last)
+	{
+		return libra::is_heap_until(first, last, std::less<>{});
+	}
+
+	template <class RndIt, class Compare>
+	constexpr bool is_heap(RndIt first, RndIt last, Compare comp)
+	{
+		return libra::is_heap_until(first, last, comp) == last;
+	}
+
+	template <class RndIt>
+	constexpr bool is_heap(RndIt first, RndIt last)
+	{
+		return libra::is_heap(first, last, std::less<>{});
+	}
+
+	// Restores the heap after the element at pos was changed, moving it up if its key
+	// increased or down if it decreased. O(log n).
+	template <class RndIt, class Compare>
+	constexpr void update_heap(RndIt first, RndIt last, RndIt pos, Compare comp)
+	{
+		assert(first <= pos && pos < last);
+		auto idx = pos - first;
+		if (idx > 0 && comp(first[(idx - 1) / 2], *pos))
+			detail::sift_up_heap(first, idx, comp);
+		else
+			detail::sift_down_heap(first, idx, last - first, comp);
+	}
+
+	template <class RndIt>
+	constexpr void update_heap(RndIt first, RndIt last, RndIt pos)
+	{
+		libra::update_heap(first, last, pos, std::less<>{});
 	}
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "../detail/buffered_ordered_container.hpp"
+
+namespace libra {
+
+	// Write-optimized ordered set. Inserts go to a small sorted buffer that is merged into
+	// the main sorted array in bulk, so sustained random inserts cost O(sqrt(n)) moves
+	// amortized rather than O(n). Iterators present the merged view of both arrays.
+	template <
+		class Key,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<Key>
+	> class buffered_ordered_set
+		: public detail::buffered_ordered_container
+					<
+						Key, // container value
+						Compare, // key comparator
+						Allocator, // container allocator
+						detail::identity<Key> // key extractor
+					>
+	{
+		using base_type = detail::buffered_ordered_container
+							<
+								Key, // container value
+								Compare, // key comparator
+								Allocator, // container allocator
+								detail::identity<Key> // key extractor
+							>;
+	public:
+
+		using typename base_type::container_type;
+		using typename base_type::key_type;
+		using typename base_type::value_type;
+		using typename base_type::size_type;
+		using typename base_type::difference_type;
+		using typename base_type::key_compare;
+		using typename base_type::value_compare;
+		using typename base_type::allocator_type;
+		using typename base_type::reference;
+		using typename base_type::const_reference;
+		using typename base_type::pointer;
+		using typename base_type::const_pointer;
+		using typename base_type::iterator;
+		using typename base_type::const_iterator;
+		using typename base_type::reverse_iterator;
+		using typename base_type::const_reverse_iterator;
+
+		// ctors
+		buffered_ordered_set() = default;
+
+		explicit buffered_ordered_set(const Compare& comp, const Allocator& alloc = Allocator())
+			: base_type(comp, alloc) {}
+
+		explicit buffered_ordered_set(const Allocator& alloc)
+			: base_type(alloc) {}
+
+		template <class InIt>
+		buffered_ordered_set(InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(first, last, comp, alloc) {}
+
+		template <class InIt>
+		buffered_ordered_set(InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(first, last, alloc) {}
+
+		template <class InIt>
+		buffered_ordered_set(sorted_unique_t tag, InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, first, last, comp, alloc) {}
+
+		template <class InIt>
+		buffered_ordered_set(sorted_unique_t tag, InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(tag, first, last, alloc) {}
+
+		buffered_ordered_set(const buffered_ordered_set&) = default;
+		buffered_ordered_set(buffered_ordered_set&&) = default;
+
+		buffered_ordered_set(std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(list, comp, alloc) {}
+
+		buffered_ordered_set(std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(list, alloc) {}
+
+		buffered_ordered_set(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, list, comp, alloc) {}
+
+		buffered_ordered_set(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(tag, list, alloc) {}
+
+		// dtor
+		~buffered_ordered_set() = default;
+
+		// assignment
+		buffered_ordered_set& operator=(const buffered_ordered_set&) = default;
+		buffered_ordered_set& operator=(buffered_ordered_set&&) = default;
+		buffered_ordered_set& operator=(std::initializer_list<value_type> list) {
+			base_type::operator=(list);
+			return *this;
+		}
+
+		using base_type::get_allocator;
+
+		// iterators
+		using base_type::begin;
+		using base_type::cbegin;
+		using base_type::rbegin;
+		using base_type::crbegin;
+
+		using base_type::end;
+		using base_type::cend;
+		using base_type::rend;
+		using base_type::crend;
+
+		// capacity
+		using base_type::empty;
+		using base_type::size;
+		using base_type::max_size;
+		using base_type::capacity;
+		using base_type::reserve;
+		using base_type::shrink_to_fit;
+		using base_type::allocated_bytes;
+		using base_type::wasted_capacity;
+		using base_type::memory_usage;
+
+		// insert buffer
+		using base_type::buffer_size;
+		using base_type::buffer_limit;
+		using base_type::set_buffer_limit;
+		using base_type::flush;
+
+		// modifiers
+		using base_type::clear;
+		using base_type::insert;
+		using base_type::emplace;
+		using base_type::emplace_hint;
+		using base_type::erase;
+		using base_type::extract;
+		using base_type::replace;
+		using base_type::swap;
+
+		// lookup
+		using base_type::count;
+		using base_type::find;
+		using base_type::contains;
+		using base_type::equal_range;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+
+		// observers
+		using base_type::key_comp;
+		using base_type::value_comp;
+
+	};
+
+}
+
+namespace std {
+	template <class Key, class Compare, class Allocator>
+	void swap(
+		libra::buffered_ordered_set<Key, Compare, Allocator>& lhs,
+		libra::buffered_ordered_set<Key, Compare, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "../detail/chunked_ordered_container.hpp"
+
+namespace libra {
+
+	// Ordered set stored as a list of sorted blocks of about a page each. Inserts and
+	// erasures only shift elements within one block, lookups search an index of block
+	// maxima, and elements can be accessed by rank. Iterators are bidirectional.
+	template <
+		class Key,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<Key>
+	> class chunked_ordered_set
+		: public detail::chunked_ordered_container
+					<
+						Key, // container value
+						Compare, // key comparator
+						Allocator, // container allocator
+						detail::identity<Key> // key extractor
+					>
+	{
+		using base_type = detail::chunked_ordered_container
+							<
+								Key, // container value
+								Compare, // key comparator
+								Allocator, // container allocator
+								detail::identity<Key> // key extractor
+							>;
+	public:
+
+		using typename base_type::container_type;
+		using typename base_type::key_type;
+		using typename base_type::value_type;
+		using typename base_type::size_type;
+		using typename base_type::difference_type;
+		using typename base_type::key_compare;
+		using typename base_type::value_compare;
+		using typename base_type::allocator_type;
+		using typename base_type::reference;
+		using typename base_type::const_reference;
+		using typename base_type::pointer;
+		using typename base_type::const_pointer;
+		using typename base_type::iterator;
+		using typename base_type::const_iterator;
+		using typename base_type::reverse_iterator;
+		using typename base_type::const_reverse_iterator;
+
+		// ctors
+		chunked_ordered_set() = default;
+
+		explicit chunked_ordered_set(const Compare& comp, const Allocator& alloc = Allocator())
+			: base_type(comp, alloc) {}
+
+		explicit chunked_ordered_set(const Allocator& alloc)
+			: base_type(alloc) {}
+
+		template <class InIt>
+		chunked_ordered_set(InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(first, last, comp, alloc) {}
+
+		template <class InIt>
+		chunked_ordered_set(InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(first, last, alloc) {}
+
+		template <class InIt>
+		chunked_ordered_set(sorted_unique_t tag, InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, first, last, comp, alloc) {}
+
+		template <class InIt>
+		chunked_ordered_set(sorted_unique_t tag, InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(tag, first, last, alloc) {}
+
+		chunked_ordered_set(const chunked_ordered_set&) = default;
+		chunked_ordered_set(chunked_ordered_set&&) = default;
+
+		chunked_ordered_set(std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(list, comp, alloc) {}
+
+		chunked_ordered_set(std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(list, alloc) {}
+
+		chunked_ordered_set(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, list, comp, alloc) {}
+
+		chunked_ordered_set(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(tag, list, alloc) {}
+
+		// dtor
+		~chunked_ordered_set() = default;
+
+		// assignment
+		chunked_ordered_set& operator=(const chunked_ordered_set&) = default;
+		chunked_ordered_set& operator=(chunked_ordered_set&&) = default;
+		chunked_ordered_set& operator=(std::initializer_list<value_type> list) {
+			base_type::operator=(list);
+			return *this;
+		}
+
+		using base_type::get_allocator;
+
+		// iterators
+		using base_type::begin;
+		using base_type::cbegin;
+		using base_type::rbegin;
+		using base_type::crbegin;
+
+		using base_type::end;
+		using base_type::cend;
+		using base_type::rend;
+		using base_type::crend;
+
+		// capacity
+		using base_type::empty;
+		using base_type::size;
+		using base_type::max_size;
+		using base_type::block_count;
+		using base_type::shrink_to_fit;
+		using base_type::allocated_bytes;
+		using base_type::wasted_capacity;
+		using base_type::memory_usage;
+
+		// modifiers
+		using base_type::clear;
+		using base_type::insert;
+		using base_type::emplace;
+		using base_type::emplace_hint;
+		using base_type::erase;
+		using base_type::extract;
+		using base_type::replace;
+		using base_type::swap;
+
+		// rank access
+		using base_type::nth;
+		using base_type::index_of;
+
+		// lookup
+		using base_type::count;
+		using base_type::find;
+		using base_type::contains;
+		using base_type::equal_range;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+
+		// observers
+		using base_type::key_comp;
+		using base_type::value_comp;
+
+	};
+
+}
+
+namespace std {
+	template <class Key, class Compare, class Allocator>
+	void swap(
+		libra::chunked_ordered_set<Key, Compare, Allocator>& lhs,
+		libra::chunked_ordered_set<Key, Compare, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
\ No newline at end of file
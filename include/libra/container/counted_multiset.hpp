@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../detail/counted_ordered_container.hpp"
+
+namespace libra {
+
+	// Ordered multiset that stores each distinct key once with its number of instances.
+	// Memory and the cost of inserting or erasing an instance depend on the number of
+	// distinct keys only, and instances can be accessed by rank. Iterators are
+	// bidirectional and constant.
+	template <
+		class Key,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<Key>
+	> class counted_multiset
+		: public detail::counted_ordered_container
+					<
+						Key, // container value
+						Compare, // key comparator
+						Allocator // container allocator
+					>
+	{
+		using base_type = detail::counted_ordered_container
+							<
+								Key, // container value
+								Compare, // key comparator
+								Allocator // container allocator
+							>;
+	public:
+
+		using typename base_type::key_type;
+		using typename base_type::value_type;
+		using typename base_type::size_type;
+		using typename base_type::difference_type;
+		using typename base_type::key_compare;
+		using typename base_type::value_compare;
+		using typename base_type::allocator_type;
+		using typename base_type::reference;
+		using typename base_type::const_reference;
+		using typename base_type::pointer;
+		using typename base_type::const_pointer;
+		using typename base_type::iterator;
+		using typename base_type::const_iterator;
+		using typename base_type::reverse_iterator;
+		using typename base_type::const_reverse_iterator;
+
+		// ctors
+		counted_multiset() = default;
+
+		explicit counted_multiset(const Compare& comp, const Allocator& alloc = Allocator())
+			: base_type(comp, alloc) {}
+
+		explicit counted_multiset(const Allocator& alloc)
+			: base_type(alloc) {}
+
+		template <class InIt>
+		counted_multiset(InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(first, last, comp, alloc) {}
+
+		template <class InIt>
+		counted_multiset(InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(first, last, alloc) {}
+
+		template <class InIt>
+		counted_multiset(sorted_equivalent_t tag, InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, first, last, comp, alloc) {}
+
+		template <class InIt>
+		counted_multiset(sorted_equivalent_t tag, InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(tag, first, last, alloc) {}
+
+		counted_multiset(const counted_multiset&) = default;
+		counted_multiset(counted_multiset&&) = default;
+
+		counted_multiset(std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(list, comp, alloc) {}
+
+		counted_multiset(std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(list, alloc) {}
+
+		counted_multiset(sorted_equivalent_t tag, std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, list, comp, alloc) {}
+
+		counted_multiset(sorted_equivalent_t tag, std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(tag, list, alloc) {}
+
+		// dtor
+		~counted_multiset() = default;
+
+		// assignment
+		counted_multiset& operator=(const counted_multiset&) = default;
+		counted_multiset& operator=(counted_multiset&&) = default;
+		counted_multiset& operator=(std::initializer_list<value_type> list) {
+			base_type::operator=(list);
+			return *this;
+		}
+
+		using base_type::get_allocator;
+
+		// iterators
+		using base_type::begin;
+		using base_type::cbegin;
+		using base_type::rbegin;
+		using base_type::crbegin;
+
+		using base_type::end;
+		using base_type::cend;
+		using base_type::rend;
+		using base_type::crend;
+
+		// capacity
+		using base_type::empty;
+		using base_type::size;
+		using base_type::max_size;
+		using base_type::run_count;
+		using base_type::reserve;
+		using base_type::shrink_to_fit;
+		using base_type::allocated_bytes;
+		using base_type::wasted_capacity;
+		using base_type::memory_usage;
+
+		// modifiers
+		using base_type::clear;
+		using base_type::insert;
+		using base_type::insert_n;
+		using base_type::emplace;
+		using base_type::emplace_hint;
+		using base_type::erase;
+		using base_type::swap;
+
+		// rank access
+		using base_type::nth;
+		using base_type::index_of;
+
+		// lookup
+		using base_type::count;
+		using base_type::find;
+		using base_type::contains;
+		using base_type::equal_range;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+
+		// observers
+		using base_type::key_comp;
+		using base_type::value_comp;
+
+	};
+
+}
+
+namespace std {
+	template <class Key, class Compare, class Allocator>
+	void swap(
+		libra::counted_multiset<Key, Compare, Allocator>& lhs,
+		libra::counted_multiset<Key, Compare, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <stdexcept>
 #include <algorithm>
 #include "../detail/iterator.hpp"
+#include "../detail/stats_policy.hpp"
+#include "../detail/memory_usage.hpp"
 
 namespace libra {
 	namespace detail {
@@ -211,8 +213,11 @@ namespace libra {
 
 	template <
 		class T,
-		class Allocator = std::allocator<T>
-	> class deque {
+		class Allocator = std::allocator<T>,
+		class Stats = no_stats
+	> class deque
+		: private detail::stats_holder<Stats>
+	{
 		using alloc_traits = std::allocator_traits<Allocator>;
 	public:
 
@@ -229,8 +234,8 @@ namespace libra {
 		using reverse_iterator       = std::reverse_iterator<iterator>;
 		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-		friend class iterator;
-		friend class const_iterator;
+		friend iterator;
+		friend const_iterator;
 
 		////////////////////////////////////////////////////////////////////////////////
 		//                               Constructors                                 //
@@ -443,6 +448,13 @@ namespace libra {
 		size_type capacity() const noexcept { return m_limit - m_data; }
 		void shrink_to_fit() { contract(); }
 
+		// See libra::memory_footprint
+		size_type allocated_bytes() const noexcept { return capacity() * sizeof(T); }
+		size_type wasted_capacity() const noexcept { return (capacity() - size()) * sizeof(T); }
+		memory_footprint memory_usage() const {
+			return detail::make_footprint(allocated_bytes(), size() * sizeof(T), begin(), end());
+		}
+
 		////////////////////////////////////////////////////////////////////////////////
 		//                                Modifiers                                   //
 		////////////////////////////////////////////////////////////////////////////////
@@ -494,13 +506,13 @@ namespace libra {
 			if (from_front < from_back) {
 				append_front(std::forward<Args>(args)...);
 				iterator it = end() - from_back;
-				std::rotate(begin(), begin() + 1, it);
+				rotate(begin(), begin() + 1, it);
 				return std::prev(it);
 			}
 			else {
 				append_back(std::forward<Args>(args)...);
 				iterator it = begin() + from_front;
-				std::rotate(it, std::prev(end()), end());
+				rotate(it, std::prev(end()), end());
 				return it;
 			}
 		}
@@ -520,13 +532,13 @@ namespace libra {
 			difference_type from_back = cend() - pos;
 			if (from_front < from_back) {
 				iterator it = end() - from_back;
-				std::rotate(begin(), it, std::next(it));
+				rotate(begin(), it, std::next(it));
 				remove_front();
 				return std::next(it);
 			}
 			else {
 				iterator it = begin() + from_front;
-				std::rotate(it, it + 1, end());
+				rotate(it, it + 1, end());
 				remove_back();
 				return it;
 			}
@@ -600,6 +612,13 @@ namespace libra {
 			}
 		}
 
+		////////////////////////////////////////////////////////////////////////////////
+		//                             Instrumentation                                //
+		////////////////////////////////////////////////////////////////////////////////
+
+		// See libra::counting_stats
+		using detail::stats_holder<Stats>::stats;
+
 	private:
 
 		// Member variables
@@ -621,6 +640,7 @@ namespace libra {
 
 		// Acquires memory for the container
 		pointer allocate(size_type cap) {
+			this->observer().on_allocate(cap * sizeof(T));
 			return alloc_traits::allocate(m_alloc, cap);
 		}
 
@@ -645,6 +665,7 @@ namespace libra {
 
 		// Transfers the contents of the container to a new memory location
 		void migrate(pointer dest) {
+			this->observer().on_move(m_size);
 			if constexpr (std::is_nothrow_move_constructible_v<T>) {
 				if (m_tail > m_head)
 					std::uninitialized_move(m_head, m_tail, dest);
@@ -799,6 +820,13 @@ namespace libra {
 
 		bool full() const noexcept { return capacity() == size(); }
 
+		// Rotates the elements in [first, last) so that middle becomes the first
+		void rotate(iterator first, iterator middle, iterator last) {
+			this->observer().on_rotate(last - first);
+			this->observer().on_move(last - first);
+			std::rotate(first, middle, last);
+		}
+
 		void steal_resources(deque&& other) {
 			m_data = other.m_data;
 			m_limit = other.m_limit;
@@ -854,33 +882,33 @@ namespace libra {
 
 	};
 
-	template <class T, class Allocator>
-	bool operator==(const deque<T, Allocator>& lhs, const deque<T, Allocator>& rhs) {
+	template <class T, class Allocator, class Stats>
+	bool operator==(const deque<T, Allocator, Stats>& lhs, const deque<T, Allocator, Stats>& rhs) {
 		return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template <class T, class Allocator>
-	bool operator!=(const deque<T, Allocator>& lhs, const deque<T, Allocator>& rhs) {
+	template <class T, class Allocator, class Stats>
+	bool operator!=(const deque<T, Allocator, Stats>& lhs, const deque<T, Allocator, Stats>& rhs) {
 		return !(lhs == rhs);
 	}
 
-	template <class T, class Allocator>
-	bool operator<(const deque<T, Allocator>& lhs, const deque<T, Allocator>& rhs) {
+	template <class T, class Allocator, class Stats>
+	bool operator<(const deque<T, Allocator, Stats>& lhs, const deque<T, Allocator, Stats>& rhs) {
 		return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
 	}
 
-	template <class T, class Allocator>
-	bool operator<=(const deque<T, Allocator>& lhs, const deque<T, Allocator>& rhs) {
+	template <class T, class Allocator, class Stats>
+	bool operator<=(const deque<T, Allocator, Stats>& lhs, const deque<T, Allocator, Stats>& rhs) {
 		return !(rhs < lhs);
 	}
 
-	template <class T, class Allocator>
-	bool operator>(const deque<T, Allocator>& lhs, const deque<T, Allocator>& rhs) {
+	template <class T, class Allocator, class Stats>
+	bool operator>(const deque<T, Allocator, Stats>& lhs, const deque<T, Allocator, Stats>& rhs) {
 		return rhs < lhs;
 	}
 
-	template <class T, class Allocator>
-	bool operator>=(const deque<T, Allocator>& lhs, const deque<T, Allocator>& rhs) {
+	template <class T, class Allocator, class Stats>
+	bool operator>=(const deque<T, Allocator, Stats>& lhs, const deque<T, Allocator, Stats>& rhs) {
 		return !(lhs < rhs);
 	}
 
@@ -888,8 +916,8 @@ namespace libra {
 
 namespace std {
 
-	template <class T, class Allocator>
-	void swap(libra::deque<T, Allocator>& lhs, libra::deque<T, Allocator>& rhs)
+	template <class T, class Allocator, class Stats>
+	void swap(libra::deque<T, Allocator, Stats>& lhs, libra::deque<T, Allocator, Stats>& rhs)
 		noexcept(noexcept(lhs.swap(rhs)))
 	{
 		lhs.swap(rhs);
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../detail/eytzinger_container.hpp"
+
+namespace libra {
+
+	// Read-optimized ordered set stored in breadth first (eytzinger) order.
+	// Lookups are faster than a sorted array on large inputs; the contents are fixed
+	// at construction and only replaced by assignment.
+	template <
+		class Key,
+		class Compare = std::less<Key>,
+		class Allocator = std::allocator<Key>
+	> class eytzinger_set
+		: public detail::eytzinger_container
+					<
+						Key, // container value
+						Compare, // key comparator
+						Allocator, // container allocator
+						detail::identity<Key> // key extractor
+					>
+	{
+		using base_type = detail::eytzinger_container
+							<
+								Key, // container value
+								Compare, // key comparator
+								Allocator, // container allocator
+								detail::identity<Key> // key extractor
+							>;
+	public:
+
+		using typename base_type::container_type;
+		using typename base_type::key_type;
+		using typename base_type::value_type;
+		using typename base_type::size_type;
+		using typename base_type::difference_type;
+		using typename base_type::key_compare;
+		using typename base_type::value_compare;
+		using typename base_type::allocator_type;
+		using typename base_type::reference;
+		using typename base_type::const_reference;
+		using typename base_type::pointer;
+		using typename base_type::const_pointer;
+		using typename base_type::iterator;
+		using typename base_type::const_iterator;
+		using typename base_type::reverse_iterator;
+		using typename base_type::const_reverse_iterator;
+
+		// ctors
+		eytzinger_set() = default;
+
+		explicit eytzinger_set(const Compare& comp, const Allocator& alloc = Allocator())
+			: base_type(comp, alloc) {}
+
+		explicit eytzinger_set(const Allocator& alloc)
+			: base_type(alloc) {}
+
+		template <class InIt>
+		eytzinger_set(InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(first, last, comp, alloc) {}
+
+		template <class InIt>
+		eytzinger_set(InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(first, last, alloc) {}
+
+		template <class InIt>
+		eytzinger_set(sorted_unique_t tag, InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, first, last, comp, alloc) {}
+
+		template <class InIt>
+		eytzinger_set(sorted_unique_t tag, InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(tag, first, last, alloc) {}
+
+		eytzinger_set(const eytzinger_set&) = default;
+		eytzinger_set(const eytzinger_set& other, const Allocator& alloc)
+			: base_type(other, alloc) {}
+
+		eytzinger_set(eytzinger_set&&) = default;
+		eytzinger_set(eytzinger_set&& other, const Allocator& alloc)
+			: base_type(std::move(other), alloc) {}
+
+		eytzinger_set(std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(list, comp, alloc) {}
+
+		eytzinger_set(std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(list, alloc) {}
+
+		eytzinger_set(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, list, comp, alloc) {}
+
+		eytzinger_set(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(tag, list, alloc) {}
+
+		// dtor
+		~eytzinger_set() = default;
+
+		// assignment
+		eytzinger_set& operator=(const eytzinger_set&) = default;
+		eytzinger_set& operator=(eytzinger_set&&) = default;
+		eytzinger_set& operator=(std::initializer_list<value_type> list) {
+			base_type::operator=(list);
+			return *this;
+		}
+
+		using base_type::get_allocator;
+
+		// iterators
+		using base_type::begin;
+		using base_type::cbegin;
+		using base_type::rbegin;
+		using base_type::crbegin;
+
+		using base_type::end;
+		using base_type::cend;
+		using base_type::rend;
+		using base_type::crend;
+
+		// capacity
+		using base_type::empty;
+		using base_type::size;
+		using base_type::max_size;
+		using base_type::shrink_to_fit;
+		using base_type::allocated_bytes;
+		using base_type::wasted_capacity;
+		using base_type::memory_usage;
+
+		// modifiers
+		using base_type::clear;
+		using base_type::swap;
+
+		// rank access
+		using base_type::nth;
+		using base_type::index_of;
+
+		// lookup
+		using base_type::count;
+		using base_type::find;
+		using base_type::contains;
+		using base_type::equal_range;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+
+		// observers
+		using base_type::key_comp;
+		using base_type::value_comp;
+
+	};
+
+}
+
+namespace std {
+	template <class Key, class Compare, class Allocator>
+	void swap(
+		libra::eytzinger_set<Key, Compare, Allocator>& lhs,
+		libra::eytzinger_set<Key, Compare, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
\ No newline at end of file
@@ -9,7 +9,9 @@ namespace libra {
 		class Key,
 		class MappedType,
 		class Compare = std::less<Key>,
-		class Allocator = std::allocator<std::pair<Key, MappedType>>
+		class Allocator = std::allocator<std::pair<Key, MappedType>>,
+		class SearchPolicy = binary_search_policy,
+		class Stats = no_stats
 	> class ordered_map 
 		: public detail::ordered_container
 					<
@@ -17,7 +19,9 @@ namespace libra {
 						Compare, // key comparator
 						Allocator, // container allocator type
 						detail::select1st<std::pair<Key, MappedType>>, // key extractor
-						false // duplicates not allowed
+						false, // duplicates not allowed
+						SearchPolicy, // lookup strategy
+						Stats // instrumentation
 					>
 	{
 		using base_type = detail::ordered_container
@@ -26,10 +30,21 @@ namespace libra {
 								Compare, // key comparator
 								Allocator, // container allocator type
 								detail::select1st<std::pair<Key, MappedType>>, // key extractor
-								false // duplicates not allowed
+								false, // duplicates not allowed
+								SearchPolicy, // lookup strategy
+								Stats // instrumentation
 							>;
+
+		// Keys that are looked up through a transparent comparator and converted to
+		// key_type only when an element is inserted
+		template <class K>
+		static constexpr bool is_heterogeneous_key_v = detail::is_transparent_v<K, Compare>
+			&& !std::is_same_v<std::decay_t<K>, Key>
+			&& !std::is_convertible_v<K&&, typename base_type::const_iterator>;
+
 	public:
 		
+		using typename base_type::container_type;
 		using typename base_type::key_type;
 		using mapped_type = MappedType;
 		using typename base_type::value_type;
@@ -46,6 +61,7 @@ namespace libra {
 		using typename base_type::const_iterator;
 		using typename base_type::reverse_iterator; 
 		using typename base_type::const_reverse_iterator;
+		using typename base_type::insert_commit_data;
 
 		// ctors
 		ordered_map() = default;
@@ -67,6 +83,17 @@ namespace libra {
 			const Allocator& alloc)
 			: base_type(first, last, alloc) {}
 
+		template <class InIt>
+		ordered_map(sorted_unique_t tag, InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, first, last, comp, alloc) {}
+
+		template <class InIt>
+		ordered_map(sorted_unique_t tag, InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(tag, first, last, alloc) {}
+
 		ordered_map(const ordered_map&) = default;
 		ordered_map(const ordered_map& other, const Allocator& alloc)
 			: base_type(other, alloc) {}
@@ -84,6 +111,15 @@ namespace libra {
 			const Allocator& alloc)
 			: base_type(list, alloc) {}
 
+		ordered_map(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, list, comp, alloc) {}
+
+		ordered_map(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(tag, list, alloc) {}
+
 		// dtor
 		~ordered_map() = default;
 
@@ -110,20 +146,34 @@ namespace libra {
 				return it->second;
 		}
 
-		mapped_type& operator[](const key_type& key) {
+		template <class K>
+		std::enable_if_t<is_heterogeneous_key_v<K>, mapped_type&>
+			at(const K& key) {
+			return const_cast<mapped_type&>(const_cast<const ordered_map*>(this)->at(key));
+		}
+
+		template <class K>
+		std::enable_if_t<is_heterogeneous_key_v<K>, const mapped_type&>
+			at(const K& key) const {
 			auto it = find(key);
-			if (it != end())
-				return it->second;
+			if (it == end())
+				throw std::out_of_range("No such element exists with the given key!");
 			else
-				return this->try_emplace(key).first->second;
+				return it->second;
+		}
+
+		mapped_type& operator[](const key_type& key) {
+			return this->try_emplace(key).first->second;
 		}
 
 		mapped_type& operator[](key_type&& key) {
-			auto it = find(key);
-			if (it != end())
-				return it->second;
-			else
-				return this->try_emplace(std::move(key)).first->second;
+			return this->try_emplace(std::move(key)).first->second;
+		}
+
+		template <class K>
+		std::enable_if_t<is_heterogeneous_key_v<K>, mapped_type&>
+			operator[](K&& key) {
+			return this->try_emplace(std::forward<K>(key)).first->second;
 		}
 
 		// iterators
@@ -144,105 +194,165 @@ namespace libra {
 		using base_type::capacity;
 		using base_type::reserve;
 		using base_type::shrink_to_fit;
+		using base_type::allocated_bytes;
+		using base_type::wasted_capacity;
+		using base_type::memory_usage;
 
 		// modifiers
 		using base_type::clear;
 		using base_type::insert;
 		using base_type::emplace;
 		using base_type::emplace_hint;
+		using base_type::insert_check;
+		using base_type::insert_commit;
 		using base_type::erase;
+		using base_type::extract;
+		using base_type::replace;
 		using base_type::swap;
 
 		template <class M>
 		std::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
-			auto it = find(k);
-			if (it != end()) {
-				it->second = std::forward<M>(obj);
-				return { it, false };
-			}
+			insert_commit_data data;
+			auto result = insert_check(k, data);
+			if (result.second)
+				result.first = insert_commit(data, k, std::forward<M>(obj));
 			else
-				return emplace(k, std::forward<M>(obj));
+				result.first->second = std::forward<M>(obj);
+			return result;
 		}
 
 		template <class M>
 		std::pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj) {
-			auto it = find(k);
-			if (it != end()) {
-				it->second = std::forward<M>(obj);
-				return { it, false };
-			}
+			insert_commit_data data;
+			auto result = insert_check(k, data);
+			if (result.second)
+				result.first = insert_commit(data, std::move(k), std::forward<M>(obj));
+			else
+				result.first->second = std::forward<M>(obj);
+			return result;
+		}
+
+		template <class K, class M>
+		std::enable_if_t<is_heterogeneous_key_v<K>, std::pair<iterator, bool>>
+			insert_or_assign(K&& k, M&& obj) {
+			insert_commit_data data;
+			auto result = insert_check(k, data);
+			if (result.second)
+				result.first = insert_commit(data,
+					std::piecewise_construct,
+					std::forward_as_tuple(std::forward<K>(k)),
+					std::forward_as_tuple(std::forward<M>(obj)));
 			else
-				return emplace(std::move(k), std::forward<M>(obj));
+				result.first->second = std::forward<M>(obj);
+			return result;
 		}
 
 		template <class M>
 		iterator insert_or_assign(const_iterator hint, const key_type& k, M&& obj) {
-			auto it = find(k);
-			if (it != end()) {
-				it->second = std::forward<M>(obj);
-				return it;
-			}
-			else
-				return emplace_hint(hint, k, std::forward<M>(obj));
+			insert_commit_data data;
+			auto result = insert_check(hint, k, data);
+			if (result.second)
+				return insert_commit(data, k, std::forward<M>(obj));
+			result.first->second = std::forward<M>(obj);
+			return result.first;
 		}
 
 		template <class M>
 		iterator insert_or_assign(const_iterator hint, key_type&& k, M&& obj) {
-			auto it = find(k);
-			if (it != end()) {
-				it->second = std::forward<M>(obj);
-				return it;
-			}
-			else
-				return emplace_hint(hint, std::move(k), std::forward<M>(obj));
+			insert_commit_data data;
+			auto result = insert_check(hint, k, data);
+			if (result.second)
+				return insert_commit(data, std::move(k), std::forward<M>(obj));
+			result.first->second = std::forward<M>(obj);
+			return result.first;
+		}
+
+		template <class K, class M>
+		std::enable_if_t<is_heterogeneous_key_v<K>, iterator>
+			insert_or_assign(const_iterator hint, K&& k, M&& obj) {
+			insert_commit_data data;
+			auto result = insert_check(hint, k, data);
+			if (result.second)
+				return insert_commit(data,
+					std::piecewise_construct,
+					std::forward_as_tuple(std::forward<K>(k)),
+					std::forward_as_tuple(std::forward<M>(obj)));
+			result.first->second = std::forward<M>(obj);
+			return result.first;
 		}
 
 		template <class... Args>
 		std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
-			auto it = find(key);
-			if (it != end())
-				return { it, false };
-			else
-				return emplace(std::piecewise_construct,
-						std::forward_as_tuple(key),
-						std::forward_as_tuple(std::forward<Args>(args)...));
+			insert_commit_data data;
+			auto result = insert_check(key, data);
+			if (result.second)
+				result.first = insert_commit(data,
+					std::piecewise_construct,
+					std::forward_as_tuple(key),
+					std::forward_as_tuple(std::forward<Args>(args)...));
+			return result;
 		}
 
 		template <class... Args>
 		std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
-			auto it = find(key);
-			if (it != end())
-				return { it, false };
-			else
-				return emplace(std::piecewise_construct,
+			insert_commit_data data;
+			auto result = insert_check(key, data);
+			if (result.second)
+				result.first = insert_commit(data,
+					std::piecewise_construct,
 					std::forward_as_tuple(std::move(key)),
 					std::forward_as_tuple(std::forward<Args>(args)...));
+			return result;
 		}
 
-		template <class... Args>
-		iterator try_emplace(const_iterator hint, const key_type& key, Args&&... args) {
-			auto it = find(key);
-			if (it != end())
-				return it;
-			else
-				return emplace_hint(hint,
+		template <class K, class... Args>
+		std::enable_if_t<is_heterogeneous_key_v<K>, std::pair<iterator, bool>>
+			try_emplace(K&& key, Args&&... args) {
+			insert_commit_data data;
+			auto result = insert_check(key, data);
+			if (result.second)
+				result.first = insert_commit(data,
 					std::piecewise_construct,
-					std::forward_as_tuple(key),
+					std::forward_as_tuple(std::forward<K>(key)),
 					std::forward_as_tuple(std::forward<Args>(args)...));
+			return result;
+		}
 
+		template <class... Args>
+		iterator try_emplace(const_iterator hint, const key_type& key, Args&&... args) {
+			insert_commit_data data;
+			auto result = insert_check(hint, key, data);
+			if (!result.second)
+				return result.first;
+			return insert_commit(data,
+				std::piecewise_construct,
+				std::forward_as_tuple(key),
+				std::forward_as_tuple(std::forward<Args>(args)...));
 		}
 
 		template <class... Args>
 		iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args) {
-			auto it = find(key);
-			if (it != end())
-				return it;
-			else
-				return emplace_hint(hint,
-					std::piecewise_construct,
-					std::forward_as_tuple(std::move(key)),
-					std::forward_as_tuple(std::forward<Args>(args)...));
+			insert_commit_data data;
+			auto result = insert_check(hint, key, data);
+			if (!result.second)
+				return result.first;
+			return insert_commit(data,
+				std::piecewise_construct,
+				std::forward_as_tuple(std::move(key)),
+				std::forward_as_tuple(std::forward<Args>(args)...));
+		}
 
+		template <class K, class... Args>
+		std::enable_if_t<is_heterogeneous_key_v<K>, iterator>
+			try_emplace(const_iterator hint, K&& key, Args&&... args) {
+			insert_commit_data data;
+			auto result = insert_check(hint, key, data);
+			if (!result.second)
+				return result.first;
+			return insert_commit(data,
+				std::piecewise_construct,
+				std::forward_as_tuple(std::forward<K>(key)),
+				std::forward_as_tuple(std::forward<Args>(args)...));
 		}
 
 		// lookup
@@ -252,20 +362,29 @@ namespace libra {
 		using base_type::equal_range;
 		using base_type::lower_bound;
 		using base_type::upper_bound;
+		using base_type::find_many;
+		using base_type::lower_bound_many;
+		using base_type::upper_bound_many;
+		using base_type::freeze;
+		using base_type::thaw;
+		using base_type::frozen;
 
 		// observers
 		using base_type::key_comp;
 		using base_type::value_comp;
 
+		// instrumentation
+		using base_type::stats;
+
 	};
 
 }
 
 namespace std {
-	template <class Key, class MappedType, class Compare, class Allocator>
+	template <class Key, class MappedType, class Compare, class Allocator, class SearchPolicy, class Stats>
 	void swap(
-		libra::ordered_map<Key, MappedType, Compare, Allocator>& lhs,
-		libra::ordered_map<Key, MappedType, Compare, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+		libra::ordered_map<Key, MappedType, Compare, Allocator, SearchPolicy, Stats>& lhs,
+		libra::ordered_map<Key, MappedType, Compare, Allocator, SearchPolicy, Stats>& rhs) noexcept(noexcept(lhs.swap(rhs)))
 	{
 		lhs.swap(rhs);
 	}
@@ -7,7 +7,9 @@ namespace libra {
 	template <
 		class Key,
 		class Compare = std::less<Key>,
-		class Allocator = std::allocator<Key>
+		class Allocator = std::allocator<Key>,
+		class SearchPolicy = binary_search_policy,
+		class Stats = no_stats
 	> class ordered_set 
 		: public detail::ordered_container
 					<
@@ -15,7 +17,9 @@ namespace libra {
 						Compare, // key comparator
 						Allocator, // container allocator
 						detail::identity<Key>, // key extractor
-						false // duplicates not allowed
+						false, // duplicates not allowed
+						SearchPolicy, // lookup strategy
+						Stats // instrumentation
 					> 
 	{
 		using base_type = detail::ordered_container
@@ -24,10 +28,13 @@ namespace libra {
 								Compare, // key comparator
 								Allocator, // container allocator
 								detail::identity<Key>, // key extractor
-								false // duplicates not allowed
+								false, // duplicates not allowed
+								SearchPolicy, // lookup strategy
+								Stats // instrumentation
 							>;
 	public:
 
+		using typename base_type::container_type;
 		using typename base_type::key_type;
 		using typename base_type::value_type;
 		using typename base_type::size_type;
@@ -43,6 +50,7 @@ namespace libra {
 		using typename base_type::const_iterator;
 		using typename base_type::reverse_iterator;
 		using typename base_type::const_reverse_iterator;
+		using typename base_type::insert_commit_data;
 
 		// ctors
 		ordered_set() = default;
@@ -64,6 +72,17 @@ namespace libra {
 			const Allocator& alloc)
 			: base_type(first, last, alloc) {}
 
+		template <class InIt>
+		ordered_set(sorted_unique_t tag, InIt first, InIt last,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, first, last, comp, alloc) {}
+
+		template <class InIt>
+		ordered_set(sorted_unique_t tag, InIt first, InIt last,
+			const Allocator& alloc)
+			: base_type(tag, first, last, alloc) {}
+
 		ordered_set(const ordered_set&) = default;
 		ordered_set(const ordered_set& other, const Allocator& alloc)
 			: base_type(other, alloc) {}
@@ -81,6 +100,15 @@ namespace libra {
 			const Allocator& alloc)
 			: base_type(list, alloc) {}
 
+		ordered_set(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator())
+			: base_type(tag, list, comp, alloc) {}
+
+		ordered_set(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Allocator& alloc)
+			: base_type(tag, list, alloc) {}
+
 		// dtor
 		~ordered_set() = default;
 
@@ -112,13 +140,20 @@ namespace libra {
 		using base_type::capacity;
 		using base_type::reserve;
 		using base_type::shrink_to_fit;
+		using base_type::allocated_bytes;
+		using base_type::wasted_capacity;
+		using base_type::memory_usage;
 
 		// modifiers
 		using base_type::clear;
 		using base_type::insert;
 		using base_type::emplace;
 		using base_type::emplace_hint;
+		using base_type::insert_check;
+		using base_type::insert_commit;
 		using base_type::erase;
+		using base_type::extract;
+		using base_type::replace;
 		using base_type::swap;
 
 		// lookup
@@ -128,20 +163,29 @@ namespace libra {
 		using base_type::equal_range;
 		using base_type::lower_bound;
 		using base_type::upper_bound;
+		using base_type::find_many;
+		using base_type::lower_bound_many;
+		using base_type::upper_bound_many;
+		using base_type::freeze;
+		using base_type::thaw;
+		using base_type::frozen;
 
 		// observers
 		using base_type::key_comp;
 		using base_type::value_comp;
 
+		// instrumentation
+		using base_type::stats;
+
 	};
 
 }
 
 namespace std {
-	template <class Key, class Compare, class Allocator>
+	template <class Key, class Compare, class Allocator, class SearchPolicy, class Stats>
 	void swap(
-		libra::ordered_set<Key, Compare, Allocator>& lhs,
-		libra::ordered_set<Key, Compare, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+		libra::ordered_set<Key, Compare, Allocator, SearchPolicy, Stats>& lhs,
+		libra::ordered_set<Key, Compare, Allocator, SearchPolicy, Stats>& rhs) noexcept(noexcept(lhs.swap(rhs)))
 	{
 		lhs.swap(rhs);
 	}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <stdexcept>
+#include "../detail/split_ordered_container.hpp"
+
+namespace libra {
+
+	// Ordered map keeping keys and mapped values in separate contiguous arrays.
+	// Lookups only touch the key array; iterators zip both arrays and yield
+	// std::pair<const Key&, MappedType&> proxies.
+	template <
+		class Key,
+		class MappedType,
+		class Compare = std::less<Key>,
+		class KeyAllocator = std::allocator<Key>,
+		class MappedAllocator = std::allocator<MappedType>
+	> class split_ordered_map
+		: public detail::split_ordered_container
+					<
+						Key, // key
+						MappedType, // mapped value
+						Compare, // key comparator
+						KeyAllocator, // key array allocator
+						MappedAllocator, // mapped array allocator
+						false // duplicates not allowed
+					>
+	{
+		using base_type = detail::split_ordered_container
+							<
+								Key, // key
+								MappedType, // mapped value
+								Compare, // key comparator
+								KeyAllocator, // key array allocator
+								MappedAllocator, // mapped array allocator
+								false // duplicates not allowed
+							>;
+	public:
+
+		using typename base_type::key_container_type;
+		using typename base_type::mapped_container_type;
+		using typename base_type::containers;
+		using typename base_type::key_type;
+		using typename base_type::mapped_type;
+		using typename base_type::value_type;
+		using typename base_type::size_type;
+		using typename base_type::difference_type;
+		using typename base_type::key_compare;
+		using typename base_type::value_compare;
+		using typename base_type::reference;
+		using typename base_type::const_reference;
+		using typename base_type::pointer;
+		using typename base_type::const_pointer;
+		using typename base_type::iterator;
+		using typename base_type::const_iterator;
+		using typename base_type::reverse_iterator;
+		using typename base_type::const_reverse_iterator;
+
+		// ctors
+		split_ordered_map() = default;
+
+		explicit split_ordered_map(const Compare& comp)
+			: base_type(comp) {}
+
+		template <class InIt>
+		split_ordered_map(InIt first, InIt last,
+			const Compare& comp = Compare())
+			: base_type(first, last, comp) {}
+
+		template <class InIt>
+		split_ordered_map(sorted_unique_t tag, InIt first, InIt last,
+			const Compare& comp = Compare())
+			: base_type(tag, first, last, comp) {}
+
+		split_ordered_map(const split_ordered_map&) = default;
+		split_ordered_map(split_ordered_map&&) = default;
+
+		split_ordered_map(std::initializer_list<value_type> list,
+			const Compare& comp = Compare())
+			: base_type(list, comp) {}
+
+		split_ordered_map(sorted_unique_t tag, std::initializer_list<value_type> list,
+			const Compare& comp = Compare())
+			: base_type(tag, list, comp) {}
+
+		// dtor
+		~split_ordered_map() = default;
+
+		// assignment
+		split_ordered_map& operator=(const split_ordered_map&) = default;
+		split_ordered_map& operator=(split_ordered_map&&) = default;
+		split_ordered_map& operator=(std::initializer_list<value_type> list) {
+			base_type::operator=(list);
+			return *this;
+		}
+
+		// element access
+		mapped_type& at(const Key& key) {
+			return const_cast<mapped_type&>(const_cast<const split_ordered_map*>(this)->at(key));
+		}
+
+		const mapped_type& at(const Key& key) const {
+			auto it = find(key);
+			if (it == end())
+				throw std::out_of_range("No such element exists with the given key!");
+			else
+				return it->second;
+		}
+
+		mapped_type& operator[](const key_type& key) {
+			auto it = find(key);
+			if (it != end())
+				return it->second;
+			else
+				return this->try_emplace(key).first->second;
+		}
+
+		mapped_type& operator[](key_type&& key) {
+			auto it = find(key);
+			if (it != end())
+				return it->second;
+			else
+				return this->try_emplace(std::move(key)).first->second;
+		}
+
+		// iterators
+		using base_type::begin;
+		using base_type::cbegin;
+		using base_type::rbegin;
+		using base_type::crbegin;
+
+		using base_type::end;
+		using base_type::cend;
+		using base_type::rend;
+		using base_type::crend;
+
+		// capacity
+		using base_type::empty;
+		using base_type::size;
+		using base_type::max_size;
+		using base_type::capacity;
+		using base_type::reserve;
+		using base_type::shrink_to_fit;
+		using base_type::allocated_bytes;
+		using base_type::wasted_capacity;
+		using base_type::memory_usage;
+
+		// modifiers
+		using base_type::clear;
+		using base_type::insert;
+		using base_type::emplace;
+		using base_type::emplace_hint;
+		using base_type::erase;
+		using base_type::extract;
+		using base_type::replace;
+		using base_type::swap;
+
+		template <class M>
+		std::pair<iterator, bool> insert_or_assign(const key_type& k, M&& obj) {
+			auto it = find(k);
+			if (it != end()) {
+				it->second = std::forward<M>(obj);
+				return { it, false };
+			}
+			else
+				return emplace(k, std::forward<M>(obj));
+		}
+
+		template <class M>
+		std::pair<iterator, bool> insert_or_assign(key_type&& k, M&& obj) {
+			auto it = find(k);
+			if (it != end()) {
+				it->second = std::forward<M>(obj);
+				return { it, false };
+			}
+			else
+				return emplace(std::move(k), std::forward<M>(obj));
+		}
+
+		template <class M>
+		iterator insert_or_assign(const_iterator hint, const key_type& k, M&& obj) {
+			auto it = find(k);
+			if (it != end()) {
+				it->second = std::forward<M>(obj);
+				return it;
+			}
+			else
+				return emplace_hint(hint, k, std::forward<M>(obj));
+		}
+
+		template <class M>
+		iterator insert_or_assign(const_iterator hint, key_type&& k, M&& obj) {
+			auto it = find(k);
+			if (it != end()) {
+				it->second = std::forward<M>(obj);
+				return it;
+			}
+			else
+				return emplace_hint(hint, std::move(k), std::forward<M>(obj));
+		}
+
+		template <class... Args>
+		std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+			auto it = find(key);
+			if (it != end())
+				return { it, false };
+			else
+				return emplace(std::piecewise_construct,
+					std::forward_as_tuple(key),
+					std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		template <class... Args>
+		std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+			auto it = find(key);
+			if (it != end())
+				return { it, false };
+			else
+				return emplace(std::piecewise_construct,
+					std::forward_as_tuple(std::move(key)),
+					std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		template <class... Args>
+		iterator try_emplace(const_iterator hint, const key_type& key, Args&&... args) {
+			auto it = find(key);
+			if (it != end())
+				return it;
+			else
+				return emplace_hint(hint,
+					std::piecewise_construct,
+					std::forward_as_tuple(key),
+					std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		template <class... Args>
+		iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args) {
+			auto it = find(key);
+			if (it != end())
+				return it;
+			else
+				return emplace_hint(hint,
+					std::piecewise_construct,
+					std::forward_as_tuple(std::move(key)),
+					std::forward_as_tuple(std::forward<Args>(args)...));
+		}
+
+		// lookup
+		using base_type::count;
+		using base_type::find;
+		using base_type::contains;
+		using base_type::equal_range;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+
+		// observers
+		using base_type::key_comp;
+		using base_type::value_comp;
+		using base_type::keys;
+		using base_type::values;
+
+	};
+
+}
+
+namespace std {
+	template <class Key, class MappedType, class Compare, class KeyAllocator, class MappedAllocator>
+	void swap(
+		libra::split_ordered_map<Key, MappedType, Compare, KeyAllocator, MappedAllocator>& lhs,
+		libra::split_ordered_map<Key, MappedType, Compare, KeyAllocator, MappedAllocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
\ No newline at end of file
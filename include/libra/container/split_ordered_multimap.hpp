@@ -0,0 +1,153 @@
+#pragma once
+
+#include "../detail/split_ordered_container.hpp"
+
+namespace libra {
+
+	// Ordered map keeping keys and mapped values in separate contiguous arrays.
+	// Lookups only touch the key array; iterators zip both arrays and yield
+	// std::pair<const Key&, MappedType&> proxies.
+	template <
+		class Key,
+		class MappedType,
+		class Compare = std::less<Key>,
+		class KeyAllocator = std::allocator<Key>,
+		class MappedAllocator = std::allocator<MappedType>
+	> class split_ordered_multimap
+		: public detail::split_ordered_container
+					<
+						Key, // key
+						MappedType, // mapped value
+						Compare, // key comparator
+						KeyAllocator, // key array allocator
+						MappedAllocator, // mapped array allocator
+						true // duplicates allowed
+					>
+	{
+		using base_type = detail::split_ordered_container
+							<
+								Key, // key
+								MappedType, // mapped value
+								Compare, // key comparator
+								KeyAllocator, // key array allocator
+								MappedAllocator, // mapped array allocator
+								true // duplicates allowed
+							>;
+	public:
+
+		using typename base_type::key_container_type;
+		using typename base_type::mapped_container_type;
+		using typename base_type::containers;
+		using typename base_type::key_type;
+		using typename base_type::mapped_type;
+		using typename base_type::value_type;
+		using typename base_type::size_type;
+		using typename base_type::difference_type;
+		using typename base_type::key_compare;
+		using typename base_type::value_compare;
+		using typename base_type::reference;
+		using typename base_type::const_reference;
+		using typename base_type::pointer;
+		using typename base_type::const_pointer;
+		using typename base_type::iterator;
+		using typename base_type::const_iterator;
+		using typename base_type::reverse_iterator;
+		using typename base_type::const_reverse_iterator;
+
+		// ctors
+		split_ordered_multimap() = default;
+
+		explicit split_ordered_multimap(const Compare& comp)
+			: base_type(comp) {}
+
+		template <class InIt>
+		split_ordered_multimap(InIt first, InIt last,
+			const Compare& comp = Compare())
+			: base_type(first, last, comp) {}
+
+		template <class InIt>
+		split_ordered_multimap(sorted_equivalent_t tag, InIt first, InIt last,
+			const Compare& comp = Compare())
+			: base_type(tag, first, last, comp) {}
+
+		split_ordered_multimap(const split_ordered_multimap&) = default;
+		split_ordered_multimap(split_ordered_multimap&&) = default;
+
+		split_ordered_multimap(std::initializer_list<value_type> list,
+			const Compare& comp = Compare())
+			: base_type(list, comp) {}
+
+		split_ordered_multimap(sorted_equivalent_t tag, std::initializer_list<value_type> list,
+			const Compare& comp = Compare())
+			: base_type(tag, list, comp) {}
+
+		// dtor
+		~split_ordered_multimap() = default;
+
+		// assignment
+		split_ordered_multimap& operator=(const split_ordered_multimap&) = default;
+		split_ordered_multimap& operator=(split_ordered_multimap&&) = default;
+		split_ordered_multimap& operator=(std::initializer_list<value_type> list) {
+			base_type::operator=(list);
+			return *this;
+		}
+
+		// iterators
+		using base_type::begin;
+		using base_type::cbegin;
+		using base_type::rbegin;
+		using base_type::crbegin;
+
+		using base_type::end;
+		using base_type::cend;
+		using base_type::rend;
+		using base_type::crend;
+
+		// capacity
+		using base_type::empty;
+		using base_type::size;
+		using base_type::max_size;
+		using base_type::capacity;
+		using base_type::reserve;
+		using base_type::shrink_to_fit;
+		using base_type::allocated_bytes;
+		using base_type::wasted_capacity;
+		using base_type::memory_usage;
+
+		// modifiers
+		using base_type::clear;
+		using base_type::insert;
+		using base_type::emplace;
+		using base_type::emplace_hint;
+		using base_type::erase;
+		using base_type::extract;
+		using base_type::replace;
+		using base_type::swap;
+
+		// lookup
+		using base_type::count;
+		using base_type::find;
+		using base_type::contains;
+		using base_type::equal_range;
+		using base_type::lower_bound;
+		using base_type::upper_bound;
+
+		// observers
+		using base_type::key_comp;
+		using base_type::value_comp;
+		using base_type::keys;
+		using base_type::values;
+
+	};
+
+}
+
+namespace std {
+	template <class Key, class MappedType, class Compare, class KeyAllocator, class MappedAllocator>
+	void swap(
+		libra::split_ordered_multimap<Key, MappedType, Compare, KeyAllocator, MappedAllocator>& lhs,
+		libra::split_ordered_multimap<Key, MappedType, Compare, KeyAllocator, MappedAllocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+	{
+		lhs.swap(rhs);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,651 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include "sorted_tags.hpp"
+#include "is_transparent.hpp"
+#include "merge_appended.hpp"
+#include "ordered_container.hpp"
+#include "../algorithm/binary_search.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Bidirectional iterator over the merged view of a buffered container's main array and
+		// insert buffer. A position is a pair of indices, one into each array, such that every
+		// element before either index precedes the element designated.
+		template <
+			class Container,
+			bool IsConst = false
+		> class buffered_iterator {
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type        = typename Container::value_type;
+			using difference_type   = typename Container::difference_type;
+			using size_type         = typename Container::size_type;
+			using reference = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_reference,
+					typename Container::reference
+				>;
+			using pointer = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_pointer,
+					typename Container::pointer
+				>;
+
+			friend class buffered_iterator<Container, !IsConst>;
+			friend Container;
+
+		private:
+
+			using container_pointer = std::conditional_t<IsConst, const Container*, Container*>;
+
+			container_pointer m_cont = nullptr;
+			size_type m_main = 0;
+			size_type m_buffer = 0;
+
+			// Whether the designated element lives in the main array
+			bool in_main() const {
+				return m_buffer == m_cont->m_buffer.size()
+					|| (m_main != m_cont->m_data.size() && m_cont->m_val_cmp(m_cont->m_data[m_main], m_cont->m_buffer[m_buffer]));
+			}
+
+		public:
+
+			buffered_iterator() = default;
+
+			buffered_iterator(container_pointer cont, size_type main, size_type buffer)
+				: m_cont(cont), m_main(main), m_buffer(buffer) {}
+
+			// non const to const iterator
+			template <bool is_const = IsConst, class = std::enable_if_t<is_const>>
+			buffered_iterator(const buffered_iterator<Container, false>& it)
+				: m_cont(it.m_cont)
+				, m_main(it.m_main)
+				, m_buffer(it.m_buffer) {}
+
+			// pointer-like operators
+
+			reference operator*() const {
+				return *(operator->());
+			}
+
+			pointer operator->() const {
+				assert(m_main + m_buffer != m_cont->size() && "Iterator not dereferenceable!");
+				return in_main() ? m_cont->m_data.data() + m_main : m_cont->m_buffer.data() + m_buffer;
+			}
+
+			// increment
+
+			buffered_iterator& operator++() {
+				assert(m_main + m_buffer != m_cont->size() && "Increment out of bounds!");
+				if (in_main())
+					++m_main;
+				else
+					++m_buffer;
+				return *this;
+			}
+
+			buffered_iterator operator++(int) {
+				buffered_iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+
+			// decrement
+
+			buffered_iterator& operator--() {
+				assert(m_main + m_buffer != 0 && "Decrement out of bounds!");
+				if (m_buffer == 0
+					|| (m_main != 0 && m_cont->m_val_cmp(m_cont->m_buffer[m_buffer - 1], m_cont->m_data[m_main - 1])))
+					--m_main;
+				else
+					--m_buffer;
+				return *this;
+			}
+
+			buffered_iterator operator--(int) {
+				buffered_iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			// comparison
+
+			template <bool is_const>
+			bool operator==(const buffered_iterator<Container, is_const>& it) const noexcept {
+				return m_main == it.m_main && m_buffer == it.m_buffer;
+			}
+
+			template <bool is_const>
+			bool operator!=(const buffered_iterator<Container, is_const>& it) const noexcept {
+				return !(*this == it);
+			}
+
+		};
+
+		// Sorted container of unique keys for write-heavy workloads. New elements go to a small
+		// sorted insert buffer, searched alongside the main sorted array, which is merged into
+		// the main array in one pass once it outgrows its limit. With the default limit of
+		// about sqrt(n) elements an insert shifts O(sqrt(n)) elements amortized, instead of the
+		// n / 2 of an ordered_container, while a lookup costs two binary searches. Iterators
+		// present the merged view of both arrays and are invalidated by every modification.
+		template <
+			class Value,
+			class Compare,
+			class Allocator,
+			class ExtractKey
+		> class buffered_ordered_container {
+		public:
+
+			using container_type         = std::vector<Value, Allocator>;
+			using key_type               = typename ExtractKey::type;
+			using value_type             = typename container_type::value_type;
+			using size_type              = typename container_type::size_type;
+			using difference_type        = typename container_type::difference_type;
+			using key_compare            = Compare;
+			using value_compare          = ValueCompare<Value, Compare, ExtractKey>;
+			using allocator_type         = typename container_type::allocator_type;
+			using reference              = typename container_type::reference;
+			using const_reference        = typename container_type::const_reference;
+			using pointer                = typename container_type::pointer;
+			using const_pointer          = typename container_type::const_pointer;
+			using iterator               = buffered_iterator<buffered_ordered_container>;
+			using const_iterator         = buffered_iterator<buffered_ordered_container, true>;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			friend iterator;
+			friend const_iterator;
+
+			// Smallest limit of the adaptive insert buffer
+			static constexpr size_type min_buffer_limit = 64;
+
+		private:
+
+			key_compare m_key_cmp;
+			value_compare m_val_cmp;
+			ExtractKey m_extract;
+			container_type m_data;
+			container_type m_buffer;
+			size_type m_buffer_limit = 0; // 0 selects the adaptive limit
+
+			template <class K1, class K2>
+			bool equivalent(const K1& lhs, const K2& rhs) const {
+				return !m_key_cmp(lhs, rhs) && !m_key_cmp(rhs, lhs);
+			}
+
+			bool range_in_order(const value_type* first, const value_type* last) const {
+				auto out_of_order = [this](const value_type& lhs, const value_type& rhs) {
+					return !m_val_cmp(lhs, rhs);
+				};
+				return std::adjacent_find(first, last, out_of_order) == last;
+			}
+
+			template <class Key>
+			size_type main_lower(const Key& key) const {
+				return detail::lower_bound(m_data.begin(), m_data.end(), key, m_key_cmp, m_extract) - m_data.begin();
+			}
+
+			template <class Key>
+			size_type buffer_lower(const Key& key) const {
+				return detail::lower_bound(m_buffer.begin(), m_buffer.end(), key, m_key_cmp, m_extract) - m_buffer.begin();
+			}
+
+			template <class Key>
+			size_type main_upper(const Key& key) const {
+				return detail::upper_bound(m_data.begin(), m_data.end(), key, m_key_cmp, m_extract) - m_data.begin();
+			}
+
+			template <class Key>
+			size_type buffer_upper(const Key& key) const {
+				return detail::upper_bound(m_buffer.begin(), m_buffer.end(), key, m_key_cmp, m_extract) - m_buffer.begin();
+			}
+
+			// Position of the element with the given key, or size() if there is none
+			template <class Key>
+			std::pair<size_type, size_type> find_index(const Key& key) const {
+				size_type main = main_lower(key);
+				size_type buffer = buffer_lower(key);
+				if (main != m_data.size() && equivalent(m_extract(m_data[main]), key))
+					return { main, buffer };
+				if (buffer != m_buffer.size() && equivalent(m_extract(m_buffer[buffer]), key))
+					return { main, buffer };
+				return { m_data.size(), m_buffer.size() };
+			}
+
+			// Merges the sorted, duplicate free elements appended past the first n into the sorted prefix
+			void merge_sorted_back(size_type n) {
+				merge_appended<false, true>(m_data, n, m_val_cmp);
+			}
+
+			// Sorts the elements appended past the first n and merges them into the sorted prefix
+			void merge_back(size_type n) {
+				merge_appended<false, false>(m_data, n, m_val_cmp);
+			}
+
+		public:
+
+			// ctor
+			buffered_ordered_container()
+				: buffered_ordered_container(Compare(), Allocator()) {}
+
+			explicit buffered_ordered_container(const Compare& comp, const Allocator& alloc = Allocator())
+				: m_key_cmp(comp)
+				, m_val_cmp(comp)
+				, m_extract()
+				, m_data(alloc)
+				, m_buffer(alloc) {}
+
+			explicit buffered_ordered_container(const Allocator& alloc)
+				: buffered_ordered_container(Compare(), alloc) {}
+
+			template <class InIt>
+			buffered_ordered_container(InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: buffered_ordered_container(comp, alloc)
+			{
+				insert(first, last);
+			}
+
+			template <class InIt>
+			buffered_ordered_container(InIt first, InIt last,
+				const Allocator& alloc)
+				: buffered_ordered_container(first, last, Compare(), alloc) {}
+
+			template <class InIt>
+			buffered_ordered_container(sorted_unique_t tag, InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: buffered_ordered_container(comp, alloc)
+			{
+				insert(tag, first, last);
+			}
+
+			template <class InIt>
+			buffered_ordered_container(sorted_unique_t tag, InIt first, InIt last,
+				const Allocator& alloc)
+				: buffered_ordered_container(tag, first, last, Compare(), alloc) {}
+
+			buffered_ordered_container(const buffered_ordered_container&) = default;
+			buffered_ordered_container(buffered_ordered_container&&) = default;
+
+			buffered_ordered_container(std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: buffered_ordered_container(list.begin(), list.end(), comp, alloc) {}
+
+			buffered_ordered_container(std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: buffered_ordered_container(list, Compare(), alloc) {}
+
+			buffered_ordered_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: buffered_ordered_container(tag, list.begin(), list.end(), comp, alloc) {}
+
+			buffered_ordered_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: buffered_ordered_container(tag, list, Compare(), alloc) {}
+
+			// dtor
+			~buffered_ordered_container() = default;
+
+			// assignment
+			buffered_ordered_container& operator=(const buffered_ordered_container&) = default;
+			buffered_ordered_container& operator=(buffered_ordered_container&&) = default;
+			buffered_ordered_container& operator=(std::initializer_list<value_type> list) {
+				clear();
+				insert(list);
+				return *this;
+			}
+
+			allocator_type get_allocator() const noexcept { return m_data.get_allocator(); }
+
+			// iterators
+			iterator begin() noexcept { return iterator(this, 0, 0); }
+			const_iterator begin() const noexcept { return const_iterator(this, 0, 0); }
+			const_iterator cbegin() const noexcept { return begin(); }
+
+			iterator end() noexcept { return iterator(this, m_data.size(), m_buffer.size()); }
+			const_iterator end() const noexcept { return const_iterator(this, m_data.size(), m_buffer.size()); }
+			const_iterator cend() const noexcept { return end(); }
+
+			reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+			// capacity
+			bool empty() const noexcept { return m_data.empty() && m_buffer.empty(); }
+			size_type size() const noexcept { return m_data.size() + m_buffer.size(); }
+			size_type max_size() const noexcept { return m_data.max_size(); }
+			size_type capacity() const noexcept { return m_data.capacity(); }
+			void reserve(size_type new_cap) { m_data.reserve(new_cap); }
+			void shrink_to_fit() { m_data.shrink_to_fit(); m_buffer.shrink_to_fit(); }
+
+			// memory, see libra::memory_footprint
+			size_type allocated_bytes() const noexcept {
+				return vector_bytes(m_data) + vector_bytes(m_buffer);
+			}
+
+			size_type wasted_capacity() const noexcept {
+				return allocated_bytes() - size() * sizeof(value_type);
+			}
+
+			memory_footprint memory_usage() const {
+				return make_footprint(allocated_bytes(), size() * sizeof(value_type), begin(), end());
+			}
+
+			// insert buffer
+			size_type buffer_size() const noexcept { return m_buffer.size(); }
+
+			// Number of buffered elements that triggers a merge
+			size_type buffer_limit() const noexcept {
+				if (m_buffer_limit)
+					return m_buffer_limit;
+				return std::max(min_buffer_limit, static_cast<size_type>(std::sqrt(static_cast<double>(m_data.size()))));
+			}
+
+			// Fixes the buffer limit, or restores the adaptive limit when passed 0
+			void set_buffer_limit(size_type limit) {
+				m_buffer_limit = limit;
+				if (m_buffer.size() > buffer_limit())
+					flush();
+			}
+
+			// Merges the insert buffer into the main array
+			void flush() {
+				if (m_buffer.empty())
+					return;
+				size_type n = m_data.size();
+				m_data.insert(m_data.end(), std::make_move_iterator(m_buffer.begin()), std::make_move_iterator(m_buffer.end()));
+				m_buffer.clear();
+				merge_sorted_back(n);
+			}
+
+			// modifiers
+			void clear() noexcept {
+				m_data.clear();
+				m_buffer.clear();
+			}
+
+			std::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+			std::pair<iterator, bool> insert(value_type&& value) { return emplace(std::move(value)); }
+
+			iterator insert(const_iterator hint, const value_type& value) { return emplace_hint(hint, value); }
+			iterator insert(const_iterator hint, value_type&& value) { return emplace_hint(hint, std::move(value)); }
+
+			template <class InIt>
+			void insert(InIt first, InIt last) {
+				flush();
+				size_type n = size();
+				m_data.insert(m_data.end(), first, last);
+				merge_back(n);
+			}
+
+			void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+			template <class InIt>
+			void insert(sorted_unique_t, InIt first, InIt last) {
+				flush();
+				size_type n = size();
+				m_data.insert(m_data.end(), first, last);
+				assert(range_in_order(m_data.data() + n, m_data.data() + m_data.size()) && "Range is not sorted!");
+				merge_sorted_back(n);
+			}
+
+			void insert(sorted_unique_t tag, std::initializer_list<value_type> list) {
+				insert(tag, list.begin(), list.end());
+			}
+
+			template <class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args) {
+				value_type value(std::forward<Args>(args)...);
+				const auto& key = m_extract(value);
+				size_type main = main_lower(key);
+				size_type buffer = buffer_lower(key);
+				if ((main != m_data.size() && equivalent(m_extract(m_data[main]), key))
+					|| (buffer != m_buffer.size() && equivalent(m_extract(m_buffer[buffer]), key)))
+					return { iterator(this, main, buffer), false };
+				m_buffer.insert(m_buffer.begin() + buffer, std::move(value));
+				if (m_buffer.size() > buffer_limit()) {
+					flush();
+					// the elements before the new one are those preceding it in either array
+					return { iterator(this, main + buffer, 0), true };
+				}
+				return { iterator(this, main, buffer), true };
+			}
+
+			// The hint is not needed to place the element in the insert buffer
+			template <class... Args>
+			iterator emplace_hint(const_iterator, Args&&... args) {
+				return emplace(std::forward<Args>(args)...).first;
+			}
+
+			iterator erase(const_iterator pos) {
+				assert(pos != cend() && "Iterator not dereferenceable!");
+				if (pos.in_main())
+					m_data.erase(m_data.begin() + pos.m_main);
+				else
+					m_buffer.erase(m_buffer.begin() + pos.m_buffer);
+				return iterator(this, pos.m_main, pos.m_buffer);
+			}
+
+			iterator erase(const_iterator first, const_iterator last) {
+				m_data.erase(m_data.begin() + first.m_main, m_data.begin() + last.m_main);
+				m_buffer.erase(m_buffer.begin() + first.m_buffer, m_buffer.begin() + last.m_buffer);
+				return iterator(this, first.m_main, first.m_buffer);
+			}
+
+			size_type erase(const key_type& key) {
+				auto it = find(key);
+				if (it == end())
+					return 0;
+				erase(it);
+				return 1;
+			}
+
+			// Merges the insert buffer and moves the sorted array out of the container, leaving it empty
+			container_type extract() && {
+				flush();
+				container_type data(std::move(m_data));
+				clear();
+				return data;
+			}
+
+			// Adopts a sorted array of unique elements, dropping the current contents
+			void replace(container_type&& data) {
+				m_data = std::move(data);
+				m_buffer.clear();
+				assert(range_in_order(m_data.data(), m_data.data() + m_data.size()) && "Storage is not sorted!");
+			}
+
+			void swap(buffered_ordered_container& other)
+				noexcept(std::is_nothrow_swappable<Compare>::value)
+			{
+				if (this != &other) {
+					std::swap(m_key_cmp, other.m_key_cmp);
+					std::swap(m_val_cmp, other.m_val_cmp);
+					std::swap(m_extract, other.m_extract);
+					std::swap(m_data, other.m_data);
+					std::swap(m_buffer, other.m_buffer);
+					std::swap(m_buffer_limit, other.m_buffer_limit);
+				}
+			}
+
+			// lookup
+			size_type count(const key_type& key) const {
+				return contains(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, size_type>
+				count(const K& key) const {
+				return contains(key);
+			}
+
+			iterator find(const key_type& key) {
+				auto [main, buffer] = find_index(key);
+				return iterator(this, main, buffer);
+			}
+
+			const_iterator find(const key_type& key) const {
+				auto [main, buffer] = find_index(key);
+				return const_iterator(this, main, buffer);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				find(const K& key) {
+				auto [main, buffer] = find_index(key);
+				return iterator(this, main, buffer);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				find(const K& key) const {
+				auto [main, buffer] = find_index(key);
+				return const_iterator(this, main, buffer);
+			}
+
+			bool contains(const key_type& key) const {
+				return find(key) != end();
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, bool>
+				contains(const K& key) const {
+				return find(key) != end();
+			}
+
+			std::pair<iterator, iterator> equal_range(const key_type& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<iterator, iterator>>
+				equal_range(const K& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<const_iterator, const_iterator>>
+				equal_range(const K& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			iterator lower_bound(const key_type& key) {
+				return iterator(this, main_lower(key), buffer_lower(key));
+			}
+
+			const_iterator lower_bound(const key_type& key) const {
+				return const_iterator(this, main_lower(key), buffer_lower(key));
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				lower_bound(const K& key) {
+				return iterator(this, main_lower(key), buffer_lower(key));
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				lower_bound(const K& key) const {
+				return const_iterator(this, main_lower(key), buffer_lower(key));
+			}
+
+			iterator upper_bound(const key_type& key) {
+				return iterator(this, main_upper(key), buffer_upper(key));
+			}
+
+			const_iterator upper_bound(const key_type& key) const {
+				return const_iterator(this, main_upper(key), buffer_upper(key));
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				upper_bound(const K& key) {
+				return iterator(this, main_upper(key), buffer_upper(key));
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				upper_bound(const K& key) const {
+				return const_iterator(this, main_upper(key), buffer_upper(key));
+			}
+
+			// observers
+			key_compare key_comp() const { return m_key_cmp; }
+			value_compare value_comp() const { return m_val_cmp; }
+
+		};
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator==(
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			auto comp = lhs.value_comp();
+			auto equal = [&comp](const Value& lhs, const Value& rhs) {
+				return !comp(lhs, rhs) && !comp(rhs, lhs);
+			};
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), equal);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator!=(
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<(
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lhs.value_comp());
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<=(
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>(
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return rhs < lhs;
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>=(
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const buffered_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs < rhs);
+		}
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,780 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include "sorted_tags.hpp"
+#include "fenwick_tree.hpp"
+#include "is_transparent.hpp"
+#include "merge_appended.hpp"
+#include "ordered_container.hpp"
+#include "../algorithm/binary_search.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Bidirectional iterator over a chunked container, positioned by a block and an
+		// offset into it.
+		template <
+			class Container,
+			bool IsConst = false
+		> class chunked_iterator {
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type        = typename Container::value_type;
+			using difference_type   = typename Container::difference_type;
+			using size_type         = typename Container::size_type;
+			using reference = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_reference,
+					typename Container::reference
+				>;
+			using pointer = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_pointer,
+					typename Container::pointer
+				>;
+
+			friend class chunked_iterator<Container, !IsConst>;
+			friend Container;
+
+		private:
+
+			using container_pointer = std::conditional_t<IsConst, const Container*, Container*>;
+
+			container_pointer m_cont = nullptr;
+			size_type m_block = 0;
+			size_type m_offset = 0;
+
+		public:
+
+			chunked_iterator() = default;
+
+			chunked_iterator(container_pointer cont, size_type block, size_type offset)
+				: m_cont(cont), m_block(block), m_offset(offset)
+			{
+				// a position past the end of a block designates the start of the next one
+				if (m_block != m_cont->m_blocks.size() && m_offset == m_cont->m_blocks[m_block].size()) {
+					++m_block;
+					m_offset = 0;
+				}
+			}
+
+			// non const to const iterator
+			template <bool is_const = IsConst, class = std::enable_if_t<is_const>>
+			chunked_iterator(const chunked_iterator<Container, false>& it)
+				: m_cont(it.m_cont)
+				, m_block(it.m_block)
+				, m_offset(it.m_offset) {}
+
+			// pointer-like operators
+
+			reference operator*() const {
+				return *(operator->());
+			}
+
+			pointer operator->() const {
+				assert(m_block != m_cont->m_blocks.size() && "Iterator not dereferenceable!");
+				return m_cont->m_blocks[m_block].data() + m_offset;
+			}
+
+			// increment
+
+			chunked_iterator& operator++() {
+				assert(m_block != m_cont->m_blocks.size() && "Increment out of bounds!");
+				if (++m_offset == m_cont->m_blocks[m_block].size()) {
+					++m_block;
+					m_offset = 0;
+				}
+				return *this;
+			}
+
+			chunked_iterator operator++(int) {
+				chunked_iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+
+			// decrement
+
+			chunked_iterator& operator--() {
+				if (m_offset == 0) {
+					assert(m_block != 0 && "Decrement out of bounds!");
+					m_offset = m_cont->m_blocks[--m_block].size();
+				}
+				--m_offset;
+				return *this;
+			}
+
+			chunked_iterator operator--(int) {
+				chunked_iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			// comparison
+
+			template <bool is_const>
+			bool operator==(const chunked_iterator<Container, is_const>& it) const noexcept {
+				return m_block == it.m_block && m_offset == it.m_offset;
+			}
+
+			template <bool is_const>
+			bool operator!=(const chunked_iterator<Container, is_const>& it) const noexcept {
+				return !(*this == it);
+			}
+
+		};
+
+		// Sorted container of unique keys stored as a list of sorted blocks of bounded size,
+		// with an array holding the largest key of every block. A lookup binary searches the
+		// block maxima, then one block; an insert or erase only shifts elements within one
+		// block, and blocks split when they outgrow max_block_size and merge with a neighbour
+		// when they drop below a quarter of it. A Fenwick tree over the block sizes gives
+		// access by rank in O(log(n / max_block_size)).
+		template <
+			class Value,
+			class Compare,
+			class Allocator,
+			class ExtractKey
+		> class chunked_ordered_container {
+		public:
+
+			using container_type         = std::vector<Value, Allocator>;
+			using key_type               = typename ExtractKey::type;
+			using value_type             = Value;
+			using size_type              = typename container_type::size_type;
+			using difference_type        = typename container_type::difference_type;
+			using key_compare            = Compare;
+			using value_compare          = ValueCompare<Value, Compare, ExtractKey>;
+			using allocator_type         = Allocator;
+			using reference              = Value&;
+			using const_reference        = const Value&;
+			using pointer                = Value*;
+			using const_pointer          = const Value*;
+			using iterator               = chunked_iterator<chunked_ordered_container>;
+			using const_iterator         = chunked_iterator<chunked_ordered_container, true>;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			friend iterator;
+			friend const_iterator;
+
+			// Blocks span about a page, so an in-block shift stays cheap
+			static constexpr size_type max_block_size = std::max<size_type>(16, 4096 / sizeof(Value));
+
+		private:
+
+			using alloc_traits = std::allocator_traits<Allocator>;
+			using block_allocator = typename alloc_traits::template rebind_alloc<container_type>;
+			using key_allocator = typename alloc_traits::template rebind_alloc<key_type>;
+			using size_allocator = typename alloc_traits::template rebind_alloc<size_type>;
+
+			key_compare m_key_cmp;
+			value_compare m_val_cmp;
+			ExtractKey m_extract;
+			std::vector<container_type, block_allocator> m_blocks;
+			std::vector<key_type, key_allocator> m_maxes;
+			fenwick_tree<size_allocator> m_tree; // block sizes
+			size_type m_size = 0;
+
+			template <class K1, class K2>
+			bool equivalent(const K1& lhs, const K2& rhs) const {
+				return !m_key_cmp(lhs, rhs) && !m_key_cmp(rhs, lhs);
+			}
+
+			// Rebuilds the block maxima and the Fenwick tree after blocks were added or removed
+			void reindex() {
+				m_maxes.clear();
+				for (const auto& block : m_blocks)
+					m_maxes.push_back(m_extract(block.back()));
+				m_tree.assign(m_blocks.size(), [this](size_type b) { return m_blocks[b].size(); });
+			}
+
+			// Merges an underfull block with a neighbour, splitting again if that overflows.
+			// The block maxima and the Fenwick tree are left for reindex() to rebuild.
+			void merge_underfull(size_type block) {
+				if (m_blocks.size() == 1 || m_blocks[block].size() >= max_block_size / 4)
+					return;
+				size_type left = block + 1 == m_blocks.size() ? block - 1 : block;
+				container_type& lower = m_blocks[left];
+				container_type& upper = m_blocks[left + 1];
+				lower.insert(lower.end(), std::make_move_iterator(upper.begin()), std::make_move_iterator(upper.end()));
+				m_blocks.erase(m_blocks.begin() + left + 1);
+				if (lower.size() > max_block_size) {
+					size_type half = lower.size() / 2;
+					container_type rest(std::make_move_iterator(lower.begin() + half),
+						std::make_move_iterator(lower.end()), lower.get_allocator());
+					lower.erase(lower.begin() + half, lower.end());
+					m_blocks.insert(m_blocks.begin() + left + 1, std::move(rest));
+				}
+			}
+
+			// Index of the first block whose largest key is not ordered before key, or not
+			// after it when Upper
+			template <bool Upper, class Key>
+			size_type find_block(const Key& key) const {
+				if constexpr (Upper)
+					return detail::upper_bound(m_maxes.begin(), m_maxes.end(), key, m_key_cmp, identity<key_type>()) - m_maxes.begin();
+				else
+					return detail::lower_bound(m_maxes.begin(), m_maxes.end(), key, m_key_cmp, identity<key_type>()) - m_maxes.begin();
+			}
+
+			template <bool Upper, class Key>
+			std::pair<size_type, size_type> bound_position(const Key& key) const {
+				size_type block = find_block<Upper>(key);
+				if (block == m_blocks.size())
+					return { block, 0 };
+				const container_type& data = m_blocks[block];
+				if constexpr (Upper)
+					return { block, detail::upper_bound(data.begin(), data.end(), key, m_key_cmp, m_extract) - data.begin() };
+				else
+					return { block, detail::lower_bound(data.begin(), data.end(), key, m_key_cmp, m_extract) - data.begin() };
+			}
+
+			template <class Key>
+			std::pair<size_type, size_type> find_position(const Key& key) const {
+				auto [block, offset] = bound_position<false>(key);
+				if (block != m_blocks.size() && equivalent(m_extract(m_blocks[block][offset]), key))
+					return { block, offset };
+				return { m_blocks.size(), 0 };
+			}
+
+			// Cuts the elements of values into half full blocks
+			void assign(container_type& values) {
+				m_blocks.clear();
+				m_size = values.size();
+				size_type per_block = max_block_size / 2;
+				for (size_type first = 0; first < values.size(); first += per_block) {
+					size_type last = std::min(values.size(), first + per_block);
+					m_blocks.emplace_back(std::make_move_iterator(values.begin() + first),
+						std::make_move_iterator(values.begin() + last), values.get_allocator());
+				}
+				reindex();
+			}
+
+			container_type flatten() {
+				container_type values(m_blocks.empty() ? Allocator() : m_blocks.front().get_allocator());
+				values.reserve(m_size);
+				for (auto& block : m_blocks)
+					values.insert(values.end(), std::make_move_iterator(block.begin()), std::make_move_iterator(block.end()));
+				return values;
+			}
+
+			template <bool Sorted, class InIt>
+			void insert_range(InIt first, InIt last) {
+				container_type values = flatten();
+				auto n = values.size();
+				values.insert(values.end(), first, last);
+				assert((!Sorted || std::is_sorted(values.begin() + n, values.end(), m_val_cmp)) && "Range is not sorted!");
+				merge_appended<false, Sorted>(values, n, m_val_cmp);
+				assign(values);
+			}
+
+		public:
+
+			// ctor
+			chunked_ordered_container()
+				: chunked_ordered_container(Compare(), Allocator()) {}
+
+			explicit chunked_ordered_container(const Compare& comp, const Allocator& alloc = Allocator())
+				: m_key_cmp(comp)
+				, m_val_cmp(comp)
+				, m_extract()
+				, m_blocks(block_allocator(alloc))
+				, m_maxes(key_allocator(alloc))
+				, m_tree(size_allocator(alloc)) {}
+
+			explicit chunked_ordered_container(const Allocator& alloc)
+				: chunked_ordered_container(Compare(), alloc) {}
+
+			template <class InIt>
+			chunked_ordered_container(InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: chunked_ordered_container(comp, alloc)
+			{
+				insert(first, last);
+			}
+
+			template <class InIt>
+			chunked_ordered_container(InIt first, InIt last,
+				const Allocator& alloc)
+				: chunked_ordered_container(first, last, Compare(), alloc) {}
+
+			template <class InIt>
+			chunked_ordered_container(sorted_unique_t tag, InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: chunked_ordered_container(comp, alloc)
+			{
+				insert(tag, first, last);
+			}
+
+			template <class InIt>
+			chunked_ordered_container(sorted_unique_t tag, InIt first, InIt last,
+				const Allocator& alloc)
+				: chunked_ordered_container(tag, first, last, Compare(), alloc) {}
+
+			chunked_ordered_container(const chunked_ordered_container&) = default;
+			chunked_ordered_container(chunked_ordered_container&& other) noexcept
+				: m_key_cmp(std::move(other.m_key_cmp))
+				, m_val_cmp(std::move(other.m_val_cmp))
+				, m_extract(std::move(other.m_extract))
+				, m_blocks(std::move(other.m_blocks))
+				, m_maxes(std::move(other.m_maxes))
+				, m_tree(std::move(other.m_tree))
+				, m_size(std::exchange(other.m_size, 0))
+			{
+				other.clear();
+			}
+
+			chunked_ordered_container(std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: chunked_ordered_container(list.begin(), list.end(), comp, alloc) {}
+
+			chunked_ordered_container(std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: chunked_ordered_container(list, Compare(), alloc) {}
+
+			chunked_ordered_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: chunked_ordered_container(tag, list.begin(), list.end(), comp, alloc) {}
+
+			chunked_ordered_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: chunked_ordered_container(tag, list, Compare(), alloc) {}
+
+			// dtor
+			~chunked_ordered_container() = default;
+
+			// assignment
+			chunked_ordered_container& operator=(const chunked_ordered_container&) = default;
+			chunked_ordered_container& operator=(chunked_ordered_container&& other) noexcept {
+				if (this != &other) {
+					chunked_ordered_container thief(std::move(other));
+					swap(thief);
+				}
+				return *this;
+			}
+
+			chunked_ordered_container& operator=(std::initializer_list<value_type> list) {
+				clear();
+				insert(list);
+				return *this;
+			}
+
+			allocator_type get_allocator() const noexcept { return allocator_type(m_blocks.get_allocator()); }
+
+			// iterators
+			iterator begin() noexcept { return iterator(this, 0, 0); }
+			const_iterator begin() const noexcept { return const_iterator(this, 0, 0); }
+			const_iterator cbegin() const noexcept { return begin(); }
+
+			iterator end() noexcept { return iterator(this, m_blocks.size(), 0); }
+			const_iterator end() const noexcept { return const_iterator(this, m_blocks.size(), 0); }
+			const_iterator cend() const noexcept { return end(); }
+
+			reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+			// capacity
+			bool empty() const noexcept { return m_size == 0; }
+			size_type size() const noexcept { return m_size; }
+			size_type max_size() const noexcept { return container_type().max_size(); }
+			size_type block_count() const noexcept { return m_blocks.size(); }
+
+			void shrink_to_fit() {
+				for (auto& block : m_blocks)
+					block.shrink_to_fit();
+				m_blocks.shrink_to_fit();
+				m_maxes.shrink_to_fit();
+				m_tree.shrink_to_fit();
+			}
+
+			// memory, see libra::memory_footprint
+			size_type allocated_bytes() const noexcept {
+				size_type bytes = vector_bytes(m_blocks) + vector_bytes(m_maxes) + m_tree.allocated_bytes();
+				for (const auto& block : m_blocks)
+					bytes += vector_bytes(block);
+				return bytes;
+			}
+
+			size_type wasted_capacity() const noexcept {
+				return allocated_bytes() - size() * sizeof(value_type);
+			}
+
+			memory_footprint memory_usage() const {
+				return make_footprint(allocated_bytes(), size() * sizeof(value_type), begin(), end());
+			}
+
+			// modifiers
+			void clear() noexcept {
+				m_blocks.clear();
+				m_maxes.clear();
+				m_tree.clear();
+				m_size = 0;
+			}
+
+			std::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+			std::pair<iterator, bool> insert(value_type&& value) { return emplace(std::move(value)); }
+
+			iterator insert(const_iterator hint, const value_type& value) { return emplace_hint(hint, value); }
+			iterator insert(const_iterator hint, value_type&& value) { return emplace_hint(hint, std::move(value)); }
+
+			template <class InIt>
+			void insert(InIt first, InIt last) {
+				insert_range<false>(first, last);
+			}
+
+			void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+			template <class InIt>
+			void insert(sorted_unique_t, InIt first, InIt last) {
+				insert_range<true>(first, last);
+			}
+
+			void insert(sorted_unique_t tag, std::initializer_list<value_type> list) {
+				insert(tag, list.begin(), list.end());
+			}
+
+			template <class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args) {
+				value_type value(std::forward<Args>(args)...);
+				if (m_blocks.empty()) {
+					m_blocks.emplace_back(get_allocator());
+					m_blocks.back().reserve(max_block_size);
+					m_blocks.back().push_back(std::move(value));
+					m_size = 1;
+					reindex();
+					return { begin(), true };
+				}
+				const auto& key = m_extract(value);
+				auto [block, offset] = bound_position<false>(key);
+				if (block == m_blocks.size()) {
+					// larger than every element: append to the last block
+					block = m_blocks.size() - 1;
+					offset = m_blocks[block].size();
+				}
+				else if (equivalent(m_extract(m_blocks[block][offset]), key)) {
+					return { iterator(this, block, offset), false };
+				}
+				container_type& data = m_blocks[block];
+				data.insert(data.begin() + offset, std::move(value));
+				++m_size;
+				if (data.size() > max_block_size) {
+					// split into two half full blocks
+					size_type half = data.size() / 2;
+					container_type upper(std::make_move_iterator(data.begin() + half),
+						std::make_move_iterator(data.end()), data.get_allocator());
+					data.erase(data.begin() + half, data.end());
+					m_blocks.insert(m_blocks.begin() + block + 1, std::move(upper));
+					reindex();
+					return offset < half
+						? std::make_pair(iterator(this, block, offset), true)
+						: std::make_pair(iterator(this, block + 1, offset - half), true);
+				}
+				if (offset + 1 == data.size())
+					m_maxes[block] = m_extract(data.back());
+				m_tree.add(block, 1);
+				return { iterator(this, block, offset), true };
+			}
+
+			// Positions are found from the block maxima; the hint is not needed
+			template <class... Args>
+			iterator emplace_hint(const_iterator, Args&&... args) {
+				return emplace(std::forward<Args>(args)...).first;
+			}
+
+			iterator erase(const_iterator pos) {
+				assert(pos != cend() && "Iterator not dereferenceable!");
+				size_type block = pos.m_block;
+				size_type offset = pos.m_offset;
+				container_type& data = m_blocks[block];
+				data.erase(data.begin() + offset);
+				--m_size;
+				if (data.size() >= max_block_size / 4 || m_blocks.size() == 1) {
+					if (data.empty()) {
+						clear();
+						return end();
+					}
+					if (offset == data.size())
+						m_maxes[block] = m_extract(data.back());
+					m_tree.add(block, -1);
+					return iterator(this, block, offset);
+				}
+				size_type rank = m_tree.prefix(block) + offset;
+				merge_underfull(block);
+				reindex();
+				return nth(rank);
+			}
+
+			iterator erase(const_iterator first, const_iterator last) {
+				if (first == last)
+					return iterator(this, last.m_block, last.m_offset);
+				size_type rank = index_of(first);
+				m_size -= index_of(last) - rank;
+				if (m_size == 0) {
+					clear();
+					return end();
+				}
+				// trim the first and last blocks and drop the whole blocks between them
+				size_type block = first.m_block;
+				container_type& head = m_blocks[block];
+				if (block == last.m_block) {
+					head.erase(head.begin() + first.m_offset, head.begin() + last.m_offset);
+				}
+				else {
+					head.erase(head.begin() + first.m_offset, head.end());
+					if (last.m_block != m_blocks.size()) {
+						container_type& tail = m_blocks[last.m_block];
+						tail.erase(tail.begin(), tail.begin() + last.m_offset);
+					}
+					m_blocks.erase(m_blocks.begin() + block + 1, m_blocks.begin() + last.m_block);
+					if (block + 1 != m_blocks.size())
+						merge_underfull(block + 1);
+				}
+				merge_underfull(block);
+				reindex();
+				return nth(rank);
+			}
+
+			size_type erase(const key_type& key) {
+				auto it = find(key);
+				if (it == end())
+					return 0;
+				erase(it);
+				return 1;
+			}
+
+			// Moves the elements out of the container into a sorted array, leaving it empty
+			container_type extract() && {
+				container_type values = flatten();
+				clear();
+				return values;
+			}
+
+			// Adopts the elements of a sorted array of unique elements
+			void replace(container_type&& data) {
+				assert(std::adjacent_find(data.begin(), data.end(), [this](const value_type& lhs, const value_type& rhs) {
+					return !m_val_cmp(lhs, rhs);
+				}) == data.end() && "Storage is not sorted!");
+				assign(data);
+			}
+
+			void swap(chunked_ordered_container& other) noexcept {
+				std::swap(m_key_cmp, other.m_key_cmp);
+				std::swap(m_val_cmp, other.m_val_cmp);
+				std::swap(m_extract, other.m_extract);
+				m_blocks.swap(other.m_blocks);
+				m_maxes.swap(other.m_maxes);
+				m_tree.swap(other.m_tree);
+				std::swap(m_size, other.m_size);
+			}
+
+			// rank access
+			iterator nth(size_type rank) {
+				assert(rank <= size() && "Rank out of range!");
+				if (rank == size())
+					return end();
+				auto [block, offset] = m_tree.select(rank);
+				return iterator(this, block, offset);
+			}
+
+			const_iterator nth(size_type rank) const {
+				assert(rank <= size() && "Rank out of range!");
+				if (rank == size())
+					return end();
+				auto [block, offset] = m_tree.select(rank);
+				return const_iterator(this, block, offset);
+			}
+
+			size_type index_of(const_iterator it) const {
+				return m_tree.prefix(it.m_block) + it.m_offset;
+			}
+
+			// lookup
+			size_type count(const key_type& key) const {
+				return contains(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, size_type>
+				count(const K& key) const {
+				return contains(key);
+			}
+
+			iterator find(const key_type& key) {
+				auto [block, offset] = find_position(key);
+				return iterator(this, block, offset);
+			}
+
+			const_iterator find(const key_type& key) const {
+				auto [block, offset] = find_position(key);
+				return const_iterator(this, block, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				find(const K& key) {
+				auto [block, offset] = find_position(key);
+				return iterator(this, block, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				find(const K& key) const {
+				auto [block, offset] = find_position(key);
+				return const_iterator(this, block, offset);
+			}
+
+			bool contains(const key_type& key) const {
+				return find_position(key).first != m_blocks.size();
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, bool>
+				contains(const K& key) const {
+				return find_position(key).first != m_blocks.size();
+			}
+
+			std::pair<iterator, iterator> equal_range(const key_type& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<iterator, iterator>>
+				equal_range(const K& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<const_iterator, const_iterator>>
+				equal_range(const K& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			iterator lower_bound(const key_type& key) {
+				auto [block, offset] = bound_position<false>(key);
+				return iterator(this, block, offset);
+			}
+
+			const_iterator lower_bound(const key_type& key) const {
+				auto [block, offset] = bound_position<false>(key);
+				return const_iterator(this, block, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				lower_bound(const K& key) {
+				auto [block, offset] = bound_position<false>(key);
+				return iterator(this, block, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				lower_bound(const K& key) const {
+				auto [block, offset] = bound_position<false>(key);
+				return const_iterator(this, block, offset);
+			}
+
+			iterator upper_bound(const key_type& key) {
+				auto [block, offset] = bound_position<true>(key);
+				return iterator(this, block, offset);
+			}
+
+			const_iterator upper_bound(const key_type& key) const {
+				auto [block, offset] = bound_position<true>(key);
+				return const_iterator(this, block, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				upper_bound(const K& key) {
+				auto [block, offset] = bound_position<true>(key);
+				return iterator(this, block, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				upper_bound(const K& key) const {
+				auto [block, offset] = bound_position<true>(key);
+				return const_iterator(this, block, offset);
+			}
+
+			// observers
+			key_compare key_comp() const { return m_key_cmp; }
+			value_compare value_comp() const { return m_val_cmp; }
+
+		};
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator==(
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			auto comp = lhs.value_comp();
+			auto equal = [&comp](const Value& lhs, const Value& rhs) {
+				return !comp(lhs, rhs) && !comp(rhs, lhs);
+			};
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), equal);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator!=(
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<(
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lhs.value_comp());
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<=(
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>(
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return rhs < lhs;
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>=(
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const chunked_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs < rhs);
+		}
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,619 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include "sorted_tags.hpp"
+#include "fenwick_tree.hpp"
+#include "is_transparent.hpp"
+#include "ordered_container.hpp"
+#include "../algorithm/binary_search.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Bidirectional iterator over every instance of a counted container, positioned
+		// by a run and an offset into it. Instances of a run are interchangeable, so the
+		// iterator only ever yields const references.
+		template <class Container>
+		class counted_iterator {
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type        = typename Container::value_type;
+			using difference_type   = typename Container::difference_type;
+			using size_type         = typename Container::size_type;
+			using reference         = typename Container::const_reference;
+			using pointer           = typename Container::const_pointer;
+
+			friend Container;
+
+		private:
+
+			const Container* m_cont = nullptr;
+			size_type m_run = 0;
+			size_type m_offset = 0;
+
+		public:
+
+			counted_iterator() = default;
+
+			counted_iterator(const Container* cont, size_type run, size_type offset)
+				: m_cont(cont), m_run(run), m_offset(offset)
+			{
+				// a position past the end of a run designates the start of the next one
+				if (m_run != m_cont->m_keys.size() && m_offset == m_cont->m_counts[m_run]) {
+					++m_run;
+					m_offset = 0;
+				}
+			}
+
+			// pointer-like operators
+
+			reference operator*() const {
+				return *(operator->());
+			}
+
+			pointer operator->() const {
+				assert(m_run != m_cont->m_keys.size() && "Iterator not dereferenceable!");
+				return m_cont->m_keys.data() + m_run;
+			}
+
+			// increment
+
+			counted_iterator& operator++() {
+				assert(m_run != m_cont->m_keys.size() && "Increment out of bounds!");
+				if (++m_offset == m_cont->m_counts[m_run]) {
+					++m_run;
+					m_offset = 0;
+				}
+				return *this;
+			}
+
+			counted_iterator operator++(int) {
+				counted_iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+
+			// decrement
+
+			counted_iterator& operator--() {
+				if (m_offset == 0) {
+					assert(m_run != 0 && "Decrement out of bounds!");
+					m_offset = m_cont->m_counts[--m_run];
+				}
+				--m_offset;
+				return *this;
+			}
+
+			counted_iterator operator--(int) {
+				counted_iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			// comparison
+
+			bool operator==(const counted_iterator& it) const noexcept {
+				return m_run == it.m_run && m_offset == it.m_offset;
+			}
+
+			bool operator!=(const counted_iterator& it) const noexcept {
+				return !(*this == it);
+			}
+
+		};
+
+		// Sorted multiset stored as runs: one copy of every distinct key next to the number
+		// of instances of it. Memory grows with the number of distinct keys rather than the
+		// number of instances, and adding or removing an instance of a present key only
+		// touches its count. A Fenwick tree over the counts gives access by rank in O(log d)
+		// for d distinct keys.
+		template <
+			class Key,
+			class Compare,
+			class Allocator
+		> class counted_ordered_container {
+		public:
+
+			using key_type               = Key;
+			using value_type             = Key;
+			using size_type              = std::size_t;
+			using difference_type        = std::ptrdiff_t;
+			using key_compare            = Compare;
+			using value_compare          = Compare;
+			using allocator_type         = Allocator;
+			using reference              = const Key&;
+			using const_reference        = const Key&;
+			using pointer                = const Key*;
+			using const_pointer          = const Key*;
+			using iterator               = counted_iterator<counted_ordered_container>;
+			using const_iterator         = iterator;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = reverse_iterator;
+
+			friend iterator;
+
+		private:
+
+			using alloc_traits = std::allocator_traits<Allocator>;
+			using size_allocator = typename alloc_traits::template rebind_alloc<size_type>;
+
+			key_compare m_key_cmp;
+			std::vector<Key, Allocator> m_keys;
+			std::vector<size_type, size_allocator> m_counts;
+			fenwick_tree<size_allocator> m_tree; // run counts
+			size_type m_size = 0;
+
+			template <class K1, class K2>
+			bool equivalent(const K1& lhs, const K2& rhs) const {
+				return !m_key_cmp(lhs, rhs) && !m_key_cmp(rhs, lhs);
+			}
+
+			// Rebuilds the Fenwick tree after runs were added or removed
+			void reindex() {
+				m_tree.assign(m_counts.size(), [this](size_type r) { return m_counts[r]; });
+			}
+
+			template <bool Upper, class K>
+			size_type bound_run(const K& key) const {
+				if constexpr (Upper)
+					return detail::upper_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, identity<Key>()) - m_keys.begin();
+				else
+					return detail::lower_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, identity<Key>()) - m_keys.begin();
+			}
+
+			// Index of the run of key, or the number of runs if there is none
+			template <class K>
+			size_type find_run(const K& key) const {
+				size_type run = bound_run<false>(key);
+				if (run != m_keys.size() && equivalent(m_keys[run], key))
+					return run;
+				return m_keys.size();
+			}
+
+			// Adds count instances of key; returns the position of the first one
+			template <class K>
+			iterator add(K&& key, size_type count) {
+				size_type run = bound_run<false>(key);
+				if (run != m_keys.size() && equivalent(m_keys[run], key)) {
+					size_type offset = m_counts[run];
+					m_counts[run] += count;
+					m_size += count;
+					m_tree.add(run, count);
+					return iterator(this, run, offset);
+				}
+				m_keys.insert(m_keys.begin() + run, std::forward<K>(key));
+				m_counts.insert(m_counts.begin() + run, count);
+				m_size += count;
+				reindex();
+				return iterator(this, run, 0);
+			}
+
+			// Merges the keys appended past the first n runs, each a single instance, into the
+			// sorted runs before them
+			template <bool Sorted>
+			void merge_back(size_type n) {
+				auto middle = m_keys.begin() + n;
+				if constexpr (!Sorted) {
+					if (!std::is_sorted(middle, m_keys.end(), m_key_cmp))
+						std::stable_sort(middle, m_keys.end(), m_key_cmp);
+				}
+				else {
+					assert(std::is_sorted(middle, m_keys.end(), m_key_cmp) && "Range is not sorted!");
+				}
+				m_size += m_keys.size() - n;
+				std::vector<Key, Allocator> keys(m_keys.get_allocator());
+				std::vector<size_type, size_allocator> counts(m_counts.get_allocator());
+				keys.reserve(m_keys.size());
+				counts.reserve(m_keys.size());
+				auto append = [&](Key& key, size_type count) {
+					if (!keys.empty() && equivalent(keys.back(), key))
+						counts.back() += count;
+					else {
+						keys.push_back(std::move(key));
+						counts.push_back(count);
+					}
+				};
+				size_type run = 0;
+				for (auto it = middle; it != m_keys.end(); ++it) {
+					for (; run != n && !m_key_cmp(*it, m_keys[run]); ++run)
+						append(m_keys[run], m_counts[run]);
+					append(*it, 1);
+				}
+				for (; run != n; ++run)
+					append(m_keys[run], m_counts[run]);
+				m_keys.swap(keys);
+				m_counts.swap(counts);
+				reindex();
+			}
+
+			// Removes the runs in [first, last)
+			void erase_runs(size_type first, size_type last) {
+				m_keys.erase(m_keys.begin() + first, m_keys.begin() + last);
+				m_counts.erase(m_counts.begin() + first, m_counts.begin() + last);
+			}
+
+		public:
+
+			// ctor
+			counted_ordered_container()
+				: counted_ordered_container(Compare(), Allocator()) {}
+
+			explicit counted_ordered_container(const Compare& comp, const Allocator& alloc = Allocator())
+				: m_key_cmp(comp)
+				, m_keys(alloc)
+				, m_counts(size_allocator(alloc))
+				, m_tree(size_allocator(alloc)) {}
+
+			explicit counted_ordered_container(const Allocator& alloc)
+				: counted_ordered_container(Compare(), alloc) {}
+
+			template <class InIt>
+			counted_ordered_container(InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: counted_ordered_container(comp, alloc)
+			{
+				insert(first, last);
+			}
+
+			template <class InIt>
+			counted_ordered_container(InIt first, InIt last,
+				const Allocator& alloc)
+				: counted_ordered_container(first, last, Compare(), alloc) {}
+
+			template <class InIt>
+			counted_ordered_container(sorted_equivalent_t tag, InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: counted_ordered_container(comp, alloc)
+			{
+				insert(tag, first, last);
+			}
+
+			template <class InIt>
+			counted_ordered_container(sorted_equivalent_t tag, InIt first, InIt last,
+				const Allocator& alloc)
+				: counted_ordered_container(tag, first, last, Compare(), alloc) {}
+
+			counted_ordered_container(const counted_ordered_container&) = default;
+			counted_ordered_container(counted_ordered_container&& other) noexcept
+				: m_key_cmp(std::move(other.m_key_cmp))
+				, m_keys(std::move(other.m_keys))
+				, m_counts(std::move(other.m_counts))
+				, m_tree(std::move(other.m_tree))
+				, m_size(std::exchange(other.m_size, 0))
+			{
+				other.clear();
+			}
+
+			counted_ordered_container(std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: counted_ordered_container(list.begin(), list.end(), comp, alloc) {}
+
+			counted_ordered_container(std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: counted_ordered_container(list, Compare(), alloc) {}
+
+			counted_ordered_container(sorted_equivalent_t tag, std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: counted_ordered_container(tag, list.begin(), list.end(), comp, alloc) {}
+
+			counted_ordered_container(sorted_equivalent_t tag, std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: counted_ordered_container(tag, list, Compare(), alloc) {}
+
+			// dtor
+			~counted_ordered_container() = default;
+
+			// assignment
+			counted_ordered_container& operator=(const counted_ordered_container&) = default;
+			counted_ordered_container& operator=(counted_ordered_container&& other) noexcept {
+				if (this != &other) {
+					counted_ordered_container thief(std::move(other));
+					swap(thief);
+				}
+				return *this;
+			}
+
+			counted_ordered_container& operator=(std::initializer_list<value_type> list) {
+				clear();
+				insert(list);
+				return *this;
+			}
+
+			allocator_type get_allocator() const noexcept { return m_keys.get_allocator(); }
+
+			// iterators
+			const_iterator begin() const noexcept { return const_iterator(this, 0, 0); }
+			const_iterator cbegin() const noexcept { return begin(); }
+
+			const_iterator end() const noexcept { return const_iterator(this, m_keys.size(), 0); }
+			const_iterator cend() const noexcept { return end(); }
+
+			const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+			// capacity
+			bool empty() const noexcept { return m_size == 0; }
+			size_type size() const noexcept { return m_size; }
+			size_type max_size() const noexcept { return m_counts.max_size(); }
+			size_type run_count() const noexcept { return m_keys.size(); }
+
+			void reserve(size_type runs) {
+				m_keys.reserve(runs);
+				m_counts.reserve(runs);
+				m_tree.reserve(runs);
+			}
+
+			void shrink_to_fit() {
+				m_keys.shrink_to_fit();
+				m_counts.shrink_to_fit();
+				m_tree.shrink_to_fit();
+			}
+
+			// memory, see libra::memory_footprint. Each run stores its key once.
+			size_type allocated_bytes() const noexcept {
+				return vector_bytes(m_keys) + vector_bytes(m_counts) + m_tree.allocated_bytes();
+			}
+
+			size_type wasted_capacity() const noexcept {
+				return allocated_bytes() - run_count() * sizeof(value_type);
+			}
+
+			memory_footprint memory_usage() const {
+				return make_footprint(allocated_bytes(), run_count() * sizeof(value_type), m_keys.begin(), m_keys.end());
+			}
+
+			// modifiers
+			void clear() noexcept {
+				m_keys.clear();
+				m_counts.clear();
+				m_tree.clear();
+				m_size = 0;
+			}
+
+			iterator insert(const value_type& value) { return add(value, 1); }
+			iterator insert(value_type&& value) { return add(std::move(value), 1); }
+
+			// Runs are found by their keys; the hint is not needed
+			iterator insert(const_iterator, const value_type& value) { return add(value, 1); }
+			iterator insert(const_iterator, value_type&& value) { return add(std::move(value), 1); }
+
+			// Adds count instances of value at once
+			iterator insert_n(const value_type& value, size_type count) {
+				return count == 0 ? lower_bound(value) : add(value, count);
+			}
+
+			template <class InIt>
+			void insert(InIt first, InIt last) {
+				size_type n = m_keys.size();
+				m_keys.insert(m_keys.end(), first, last);
+				merge_back<false>(n);
+			}
+
+			void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+			template <class InIt>
+			void insert(sorted_equivalent_t, InIt first, InIt last) {
+				size_type n = m_keys.size();
+				m_keys.insert(m_keys.end(), first, last);
+				merge_back<true>(n);
+			}
+
+			void insert(sorted_equivalent_t tag, std::initializer_list<value_type> list) {
+				insert(tag, list.begin(), list.end());
+			}
+
+			template <class... Args>
+			iterator emplace(Args&&... args) {
+				return add(value_type(std::forward<Args>(args)...), 1);
+			}
+
+			template <class... Args>
+			iterator emplace_hint(const_iterator, Args&&... args) {
+				return emplace(std::forward<Args>(args)...);
+			}
+
+			// Removes the single instance at pos
+			iterator erase(const_iterator pos) {
+				assert(pos != cend() && "Iterator not dereferenceable!");
+				size_type run = pos.m_run;
+				--m_size;
+				if (--m_counts[run] != 0) {
+					m_tree.add(run, -1);
+					return iterator(this, run, pos.m_offset);
+				}
+				erase_runs(run, run + 1);
+				reindex();
+				return iterator(this, run, 0);
+			}
+
+			iterator erase(const_iterator first, const_iterator last) {
+				if (first == last)
+					return last;
+				size_type rank = index_of(first);
+				m_size -= index_of(last) - rank;
+				if (first.m_run == last.m_run) {
+					m_counts[first.m_run] -= last.m_offset - first.m_offset;
+					m_tree.add(first.m_run, -static_cast<difference_type>(last.m_offset - first.m_offset));
+					return iterator(this, first.m_run, first.m_offset);
+				}
+				// keep the head of the first run and the tail of the last one
+				if (last.m_run != m_keys.size())
+					m_counts[last.m_run] -= last.m_offset;
+				m_counts[first.m_run] = first.m_offset;
+				erase_runs(first.m_offset == 0 ? first.m_run : first.m_run + 1, last.m_run);
+				reindex();
+				return nth(rank);
+			}
+
+			// Removes every instance of key
+			size_type erase(const key_type& key) {
+				size_type run = find_run(key);
+				if (run == m_keys.size())
+					return 0;
+				size_type count = m_counts[run];
+				m_size -= count;
+				erase_runs(run, run + 1);
+				reindex();
+				return count;
+			}
+
+			void swap(counted_ordered_container& other) noexcept {
+				std::swap(m_key_cmp, other.m_key_cmp);
+				m_keys.swap(other.m_keys);
+				m_counts.swap(other.m_counts);
+				m_tree.swap(other.m_tree);
+				std::swap(m_size, other.m_size);
+			}
+
+			// rank access
+			const_iterator nth(size_type rank) const {
+				assert(rank <= size() && "Rank out of range!");
+				if (rank == size())
+					return end();
+				auto [run, offset] = m_tree.select(rank);
+				return const_iterator(this, run, offset);
+			}
+
+			size_type index_of(const_iterator it) const {
+				return m_tree.prefix(it.m_run) + it.m_offset;
+			}
+
+			// lookup
+			size_type count(const key_type& key) const {
+				size_type run = find_run(key);
+				return run == m_keys.size() ? 0 : m_counts[run];
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, size_type>
+				count(const K& key) const {
+				size_type run = find_run(key);
+				return run == m_keys.size() ? 0 : m_counts[run];
+			}
+
+			const_iterator find(const key_type& key) const {
+				return const_iterator(this, find_run(key), 0);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				find(const K& key) const {
+				return const_iterator(this, find_run(key), 0);
+			}
+
+			bool contains(const key_type& key) const {
+				return find_run(key) != m_keys.size();
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, bool>
+				contains(const K& key) const {
+				return find_run(key) != m_keys.size();
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				size_type run = bound_run<false>(key);
+				size_type next = run != m_keys.size() && equivalent(m_keys[run], key) ? run + 1 : run;
+				return { const_iterator(this, run, 0), const_iterator(this, next, 0) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<const_iterator, const_iterator>>
+				equal_range(const K& key) const {
+				size_type run = bound_run<false>(key);
+				size_type next = run != m_keys.size() && equivalent(m_keys[run], key) ? run + 1 : run;
+				return { const_iterator(this, run, 0), const_iterator(this, next, 0) };
+			}
+
+			const_iterator lower_bound(const key_type& key) const {
+				return const_iterator(this, bound_run<false>(key), 0);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				lower_bound(const K& key) const {
+				return const_iterator(this, bound_run<false>(key), 0);
+			}
+
+			const_iterator upper_bound(const key_type& key) const {
+				return const_iterator(this, bound_run<true>(key), 0);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				upper_bound(const K& key) const {
+				return const_iterator(this, bound_run<true>(key), 0);
+			}
+
+			// observers
+			key_compare key_comp() const { return m_key_cmp; }
+			value_compare value_comp() const { return m_key_cmp; }
+
+		};
+
+		template <class Key, class Compare, class Allocator>
+		bool operator==(
+			const counted_ordered_container<Key, Compare, Allocator>& lhs,
+			const counted_ordered_container<Key, Compare, Allocator>& rhs)
+		{
+			auto comp = lhs.value_comp();
+			auto equal = [&comp](const Key& lhs, const Key& rhs) {
+				return !comp(lhs, rhs) && !comp(rhs, lhs);
+			};
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), equal);
+		}
+
+		template <class Key, class Compare, class Allocator>
+		bool operator!=(
+			const counted_ordered_container<Key, Compare, Allocator>& lhs,
+			const counted_ordered_container<Key, Compare, Allocator>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		template <class Key, class Compare, class Allocator>
+		bool operator<(
+			const counted_ordered_container<Key, Compare, Allocator>& lhs,
+			const counted_ordered_container<Key, Compare, Allocator>& rhs)
+		{
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lhs.value_comp());
+		}
+
+		template <class Key, class Compare, class Allocator>
+		bool operator<=(
+			const counted_ordered_container<Key, Compare, Allocator>& lhs,
+			const counted_ordered_container<Key, Compare, Allocator>& rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		template <class Key, class Compare, class Allocator>
+		bool operator>(
+			const counted_ordered_container<Key, Compare, Allocator>& lhs,
+			const counted_ordered_container<Key, Compare, Allocator>& rhs)
+		{
+			return rhs < lhs;
+		}
+
+		template <class Key, class Compare, class Allocator>
+		bool operator>=(
+			const counted_ordered_container<Key, Compare, Allocator>& lhs,
+			const counted_ordered_container<Key, Compare, Allocator>& rhs)
+		{
+			return !(lhs < rhs);
+		}
+
+	}
+}
\ No newline at end of file
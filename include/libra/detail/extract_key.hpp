@@ -6,7 +6,7 @@ namespace libra {
 		template <class T>
 		struct identity {
 			using type = T;
-			const T& operator()(const T& t) const {
+			constexpr const T& operator()(const T& t) const {
 				return t;
 			}
 		};
@@ -14,7 +14,7 @@ namespace libra {
 		template <class Pair>
 		struct select1st {
 			using type = typename Pair::first_type;
-			const type& operator()(const Pair& p) const {
+			constexpr const type& operator()(const Pair& p) const {
 				return p.first;
 			}
 		};
@@ -0,0 +1,675 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include "intrinsics.hpp"
+#include "sorted_tags.hpp"
+#include "is_transparent.hpp"
+#include "ordered_container.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Navigation of the implicit tree used by the eytzinger layout. Nodes are numbered from 1
+		// in breadth first order: the children of node k are 2k and 2k + 1. Node 0 is the end.
+		struct eytzinger_tree {
+
+			static std::size_t first(std::size_t n) noexcept {
+				if (n == 0)
+					return 0;
+				std::size_t k = 1;
+				while (2 * k <= n)
+					k = 2 * k;
+				return k;
+			}
+
+			static std::size_t last(std::size_t n) noexcept {
+				if (n == 0)
+					return 0;
+				std::size_t k = 1;
+				while (2 * k + 1 <= n)
+					k = 2 * k + 1;
+				return k;
+			}
+
+			static std::size_t next(std::size_t k, std::size_t n) noexcept {
+				if (2 * k + 1 <= n) {
+					k = 2 * k + 1;
+					while (2 * k <= n)
+						k = 2 * k;
+					return k;
+				}
+				// climb past every ancestor whose right subtree we are in
+				return k >> (detail::countr_one(k) + 1);
+			}
+
+			static std::size_t prev(std::size_t k, std::size_t n) noexcept {
+				if (k == 0)
+					return last(n);
+				if (2 * k <= n) {
+					k = 2 * k;
+					while (2 * k + 1 <= n)
+						k = 2 * k + 1;
+					return k;
+				}
+				return k >> (detail::countr_zero(k) + 1);
+			}
+
+			static std::size_t subtree_size(std::size_t k, std::size_t n) noexcept {
+				std::size_t size = 0;
+				for (std::size_t lo = k, hi = k; lo <= n; lo = 2 * lo, hi = 2 * hi + 1)
+					size += std::min(hi, n) - lo + 1;
+				return size;
+			}
+
+			// In order position of node k
+			static std::size_t rank(std::size_t k, std::size_t n) noexcept {
+				if (k == 0)
+					return n;
+				std::size_t r = subtree_size(2 * k, n);
+				for (; k > 1; k >>= 1) {
+					if (k & 1)
+						r += subtree_size(k - 1, n) + 1;
+				}
+				return r;
+			}
+
+			// Node at in order position r
+			static std::size_t select(std::size_t r, std::size_t n) noexcept {
+				if (r >= n)
+					return 0;
+				std::size_t k = 1;
+				for (;;) {
+					std::size_t left = subtree_size(2 * k, n);
+					if (r == left)
+						return k;
+					if (r < left)
+						k = 2 * k;
+					else {
+						r -= left + 1;
+						k = 2 * k + 1;
+					}
+				}
+			}
+
+		};
+
+		// Bidirectional iterator visiting an eytzinger layout in key order
+		template <
+			class Container,
+			bool IsConst = false
+		> class eytzinger_iterator {
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type        = typename Container::value_type;
+			using difference_type   = typename Container::difference_type;
+			using reference = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_reference,
+					typename Container::reference
+				>;
+			using pointer = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_pointer,
+					typename Container::pointer
+				>;
+
+			friend class eytzinger_iterator<Container, !IsConst>;
+			friend Container;
+
+		private:
+
+			pointer m_data = nullptr;
+			std::size_t m_size = 0;
+			std::size_t m_node = 0;
+
+		public:
+
+			eytzinger_iterator() = default;
+
+			eytzinger_iterator(pointer data, std::size_t size, std::size_t node)
+				: m_data(data), m_size(size), m_node(node) {}
+
+			// non const to const iterator
+			eytzinger_iterator(const eytzinger_iterator<Container, false>& it)
+				: m_data(it.m_data)
+				, m_size(it.m_size)
+				, m_node(it.m_node) {}
+
+			// pointer-like operators
+
+			reference operator*() const {
+				return *(operator->());
+			}
+
+			pointer operator->() const {
+				assert(m_node && "Iterator not dereferenceable!");
+				return m_data + (m_node - 1);
+			}
+
+			// increment
+
+			eytzinger_iterator& operator++() {
+				assert(m_node && "Increment out of bounds!");
+				m_node = eytzinger_tree::next(m_node, m_size);
+				return *this;
+			}
+
+			eytzinger_iterator operator++(int) {
+				eytzinger_iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+
+			// decrement
+
+			eytzinger_iterator& operator--() {
+				assert(m_node != eytzinger_tree::first(m_size) && "Decrement out of bounds!");
+				m_node = eytzinger_tree::prev(m_node, m_size);
+				return *this;
+			}
+
+			eytzinger_iterator operator--(int) {
+				eytzinger_iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			// comparison
+
+			template <bool is_const>
+			bool operator==(const eytzinger_iterator<Container, is_const>& it) const noexcept {
+				return m_node == it.m_node;
+			}
+
+			template <bool is_const>
+			bool operator!=(const eytzinger_iterator<Container, is_const>& it) const noexcept {
+				return !(*this == it);
+			}
+
+		};
+
+		// Read-optimized sorted container of unique keys. The elements are stored in the
+		// breadth first order of a complete binary search tree, so the top levels of every
+		// search share a handful of cache lines and a descent can prefetch the block of
+		// descendants four levels ahead. The contents are fixed at construction.
+		template <
+			class Value,
+			class Compare,
+			class Allocator,
+			class ExtractKey
+		> class eytzinger_container {
+		public:
+
+			using container_type         = std::vector<Value, Allocator>;
+			using key_type               = typename ExtractKey::type;
+			using value_type             = typename container_type::value_type;
+			using size_type              = typename container_type::size_type;
+			using difference_type        = typename container_type::difference_type;
+			using key_compare            = Compare;
+			using value_compare          = ValueCompare<Value, Compare, ExtractKey>;
+			using allocator_type         = typename container_type::allocator_type;
+			using reference              = typename container_type::reference;
+			using const_reference        = typename container_type::const_reference;
+			using pointer                = typename container_type::pointer;
+			using const_pointer          = typename container_type::const_pointer;
+			using iterator               = eytzinger_iterator<eytzinger_container>;
+			using const_iterator         = eytzinger_iterator<eytzinger_container, true>;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		private:
+
+			key_compare m_key_cmp;
+			value_compare m_val_cmp;
+			ExtractKey m_extract;
+			container_type m_data;
+
+			// Levels between a node and the descendants fetched while it is compared
+			static constexpr size_type prefetch_levels = sizeof(Value) <= 4 ? 4 : sizeof(Value) <= 8 ? 3 : sizeof(Value) <= 16 ? 2 : 1;
+
+			// Permutes sorted, unique elements into breadth first order
+			void build(container_type&& sorted) {
+				size_type n = sorted.size();
+				std::vector<size_type> rank_of(n);
+				size_type k = eytzinger_tree::first(n);
+				for (size_type r = 0; r != n; ++r, k = eytzinger_tree::next(k, n))
+					rank_of[k - 1] = r;
+				m_data.clear();
+				m_data.reserve(n);
+				for (size_type i = 0; i != n; ++i)
+					m_data.emplace_back(std::move(sorted[rank_of[i]]));
+			}
+
+			template <class InIt>
+			void assign(InIt first, InIt last) {
+				container_type sorted(first, last, get_allocator());
+				std::stable_sort(sorted.begin(), sorted.end(), m_val_cmp);
+				auto equivalent = [this](const value_type& lhs, const value_type& rhs) {
+					return !m_val_cmp(lhs, rhs);
+				};
+				sorted.erase(std::unique(sorted.begin(), sorted.end(), equivalent), sorted.end());
+				build(std::move(sorted));
+			}
+
+			template <class InIt>
+			void assign(sorted_unique_t, InIt first, InIt last) {
+				container_type sorted(first, last, get_allocator());
+				assert(std::adjacent_find(sorted.begin(), sorted.end(), [this](const value_type& lhs, const value_type& rhs) {
+					return !m_val_cmp(lhs, rhs);
+				}) == sorted.end() && "Range is not sorted and unique!");
+				build(std::move(sorted));
+			}
+
+			// Branch free descent returning the node of the first element for which before() is false.
+			// The complete levels take a fixed number of steps so consecutive searches can overlap;
+			// the partial bottom level, if any, is a single conditional step.
+			template <class Before>
+			size_type descend(Before before) const {
+				const_pointer data = m_data.data();
+				size_type n = m_data.size();
+				if (n == 0)
+					return 0;
+				size_type k = 1;
+				for (int level = 63 - detail::countl_zero(n + 1); level != 0; --level) {
+					detail::prefetch(data + (std::min(k << prefetch_levels, n) - 1));
+					k = 2 * k + static_cast<size_type>(before(m_extract(data[k - 1])));
+				}
+				size_type deeper = 2 * k + static_cast<size_type>(before(m_extract(data[std::min(k, n) - 1])));
+				k = k <= n ? deeper : k;
+				return k >> (detail::countr_one(k) + 1);
+			}
+
+			template <class Key>
+			size_type lower_node(const Key& key) const {
+				return descend([&](const auto& element) { return m_key_cmp(element, key); });
+			}
+
+			template <class Key>
+			size_type upper_node(const Key& key) const {
+				return descend([&](const auto& element) { return !m_key_cmp(key, element); });
+			}
+
+			template <class Key>
+			size_type find_node(const Key& key) const {
+				size_type k = lower_node(key);
+				return k != 0 && !m_key_cmp(key, m_extract(m_data[k - 1])) ? k : 0;
+			}
+
+			iterator make_iterator(size_type k) {
+				return iterator(m_data.data(), m_data.size(), k);
+			}
+
+			const_iterator make_iterator(size_type k) const {
+				return const_iterator(m_data.data(), m_data.size(), k);
+			}
+
+		public:
+
+			// ctor
+			eytzinger_container()
+				: eytzinger_container(Compare(), Allocator()) {}
+
+			explicit eytzinger_container(const Compare& comp, const Allocator& alloc = Allocator())
+				: m_key_cmp(comp)
+				, m_val_cmp(comp)
+				, m_extract()
+				, m_data(alloc) {}
+
+			explicit eytzinger_container(const Allocator& alloc)
+				: eytzinger_container(Compare(), alloc) {}
+
+			template <class InIt>
+			eytzinger_container(InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: eytzinger_container(comp, alloc)
+			{
+				assign(first, last);
+			}
+
+			template <class InIt>
+			eytzinger_container(InIt first, InIt last,
+				const Allocator& alloc)
+				: eytzinger_container(first, last, Compare(), alloc) {}
+
+			template <class InIt>
+			eytzinger_container(sorted_unique_t tag, InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: eytzinger_container(comp, alloc)
+			{
+				assign(tag, first, last);
+			}
+
+			template <class InIt>
+			eytzinger_container(sorted_unique_t tag, InIt first, InIt last,
+				const Allocator& alloc)
+				: eytzinger_container(tag, first, last, Compare(), alloc) {}
+
+			eytzinger_container(const eytzinger_container&) = default;
+			eytzinger_container(const eytzinger_container& other, const Allocator& alloc)
+				: m_key_cmp(other.m_key_cmp)
+				, m_val_cmp(other.m_val_cmp)
+				, m_extract(other.m_extract)
+				, m_data(other.m_data, alloc) {}
+
+			eytzinger_container(eytzinger_container&&) = default;
+			eytzinger_container(eytzinger_container&& other, const Allocator& alloc)
+				: m_key_cmp(std::move(other.m_key_cmp))
+				, m_val_cmp(std::move(other.m_val_cmp))
+				, m_extract(std::move(other.m_extract))
+				, m_data(std::move(other.m_data), alloc) {}
+
+			eytzinger_container(std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: eytzinger_container(list.begin(), list.end(), comp, alloc) {}
+
+			eytzinger_container(std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: eytzinger_container(list, Compare(), alloc) {}
+
+			eytzinger_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: eytzinger_container(tag, list.begin(), list.end(), comp, alloc) {}
+
+			eytzinger_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: eytzinger_container(tag, list, Compare(), alloc) {}
+
+			// dtor
+			~eytzinger_container() = default;
+
+			// assignment
+			eytzinger_container& operator=(const eytzinger_container&) = default;
+			eytzinger_container& operator=(eytzinger_container&&)
+				noexcept(
+					std::allocator_traits<Allocator>::is_always_equal::value
+					&& std::is_nothrow_move_assignable<Compare>::value) = default;
+			eytzinger_container& operator=(std::initializer_list<value_type> list) {
+				assign(list.begin(), list.end());
+				return *this;
+			}
+
+			allocator_type get_allocator() const {
+				return m_data.get_allocator();
+			}
+
+			// iterators
+			iterator begin() noexcept {
+				return make_iterator(eytzinger_tree::first(size()));
+			}
+
+			const_iterator begin() const noexcept {
+				return make_iterator(eytzinger_tree::first(size()));
+			}
+
+			const_iterator cbegin() const noexcept {
+				return begin();
+			}
+
+			reverse_iterator rbegin() noexcept {
+				return reverse_iterator(end());
+			}
+
+			const_reverse_iterator rbegin() const noexcept {
+				return const_reverse_iterator(end());
+			}
+
+			const_reverse_iterator crbegin() const noexcept {
+				return rbegin();
+			}
+
+			iterator end() noexcept {
+				return make_iterator(0);
+			}
+
+			const_iterator end() const noexcept {
+				return make_iterator(0);
+			}
+
+			const_iterator cend() const noexcept {
+				return end();
+			}
+
+			reverse_iterator rend() noexcept {
+				return reverse_iterator(begin());
+			}
+
+			const_reverse_iterator rend() const noexcept {
+				return const_reverse_iterator(begin());
+			}
+
+			const_reverse_iterator crend() const noexcept {
+				return rend();
+			}
+
+			// capacity
+			bool empty() const noexcept {
+				return m_data.empty();
+			}
+
+			size_type size() const noexcept {
+				return m_data.size();
+			}
+
+			size_type max_size() const noexcept {
+				return m_data.max_size();
+			}
+
+			void shrink_to_fit() {
+				m_data.shrink_to_fit();
+			}
+
+			// memory, see libra::memory_footprint
+			size_type allocated_bytes() const noexcept {
+				return vector_bytes(m_data);
+			}
+
+			size_type wasted_capacity() const noexcept {
+				return allocated_bytes() - size() * sizeof(value_type);
+			}
+
+			memory_footprint memory_usage() const {
+				return make_footprint(allocated_bytes(), size() * sizeof(value_type), m_data.begin(), m_data.end());
+			}
+
+			// modifiers
+			void clear() noexcept {
+				m_data.clear();
+			}
+
+			void swap(eytzinger_container& other)
+				noexcept(
+					std::allocator_traits<Allocator>::is_always_equal::value
+					&& std::is_nothrow_swappable<Compare>::value)
+			{
+				if (this != std::addressof(other)) {
+					std::swap(m_key_cmp, other.m_key_cmp);
+					std::swap(m_val_cmp, other.m_val_cmp);
+					std::swap(m_extract, other.m_extract);
+					std::swap(m_data, other.m_data);
+				}
+			}
+
+			// rank access
+			iterator nth(size_type rank) {
+				return make_iterator(eytzinger_tree::select(rank, size()));
+			}
+
+			const_iterator nth(size_type rank) const {
+				return make_iterator(eytzinger_tree::select(rank, size()));
+			}
+
+			size_type index_of(const_iterator it) const {
+				return eytzinger_tree::rank(it.m_node, size());
+			}
+
+			// lookup
+			size_type count(const key_type& key) const {
+				return find_node(key) != 0;
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, size_type>
+				count(const Key& key) const {
+				return find_node(key) != 0;
+			}
+
+			iterator find(const key_type& key) {
+				return make_iterator(find_node(key));
+			}
+
+			const_iterator find(const key_type& key) const {
+				return make_iterator(find_node(key));
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
+				find(const Key& key) {
+				return make_iterator(find_node(key));
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
+				find(const Key& key) const {
+				return make_iterator(find_node(key));
+			}
+
+			bool contains(const key_type& key) const {
+				return find_node(key) != 0;
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, bool>
+				contains(const Key& key) const {
+				return find_node(key) != 0;
+			}
+
+			std::pair<iterator, iterator> equal_range(const key_type& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, std::pair<iterator, iterator>>
+				equal_range(const Key& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, std::pair<const_iterator, const_iterator>>
+				equal_range(const Key& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			iterator lower_bound(const key_type& key) {
+				return make_iterator(lower_node(key));
+			}
+
+			const_iterator lower_bound(const key_type& key) const {
+				return make_iterator(lower_node(key));
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
+				lower_bound(const Key& key) {
+				return make_iterator(lower_node(key));
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
+				lower_bound(const Key& key) const {
+				return make_iterator(lower_node(key));
+			}
+
+			iterator upper_bound(const key_type& key) {
+				return make_iterator(upper_node(key));
+			}
+
+			const_iterator upper_bound(const key_type& key) const {
+				return make_iterator(upper_node(key));
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
+				upper_bound(const Key& key) {
+				return make_iterator(upper_node(key));
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
+				upper_bound(const Key& key) const {
+				return make_iterator(upper_node(key));
+			}
+
+			// observers
+			key_compare key_comp() const { return m_key_cmp; }
+			value_compare value_comp() const { return m_val_cmp; }
+
+		};
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator==(
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			auto comp = lhs.value_comp();
+			auto equal = [&comp](const auto& lhs, const auto& rhs) {
+				return !comp(lhs, rhs) && !comp(rhs, lhs);
+			};
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), equal);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator!=(
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<(
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lhs.value_comp());
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<=(
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>(
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return rhs < lhs;
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>=(
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const eytzinger_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs < rhs);
+		}
+
+	}
+}
\ No newline at end of file
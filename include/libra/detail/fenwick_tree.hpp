@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "memory_usage.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Fenwick tree over the sizes of a sequence of segments, such as the blocks of a
+		// chunked container or the runs of a counted one. It answers how many elements
+		// precede a segment and which segment holds the element of a given rank, both in
+		// O(log n) for n segments.
+		template <class SizeAllocator>
+		class fenwick_tree {
+		public:
+
+			using size_type       = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using allocator_type  = SizeAllocator;
+
+		private:
+
+			std::vector<size_type, SizeAllocator> m_tree; // 1-based
+
+		public:
+
+			fenwick_tree() = default;
+
+			explicit fenwick_tree(const SizeAllocator& alloc)
+				: m_tree(alloc) {}
+
+			// Rebuilds the tree in O(n) over n segments, segment_size(i) giving the size of the ith
+			template <class SegmentSize>
+			void assign(size_type n, SegmentSize segment_size) {
+				m_tree.assign(n + 1, 0);
+				for (size_type i = 1; i <= n; ++i) {
+					m_tree[i] += segment_size(i - 1);
+					size_type parent = i + (i & (~i + 1));
+					if (parent <= n)
+						m_tree[parent] += m_tree[i];
+				}
+			}
+
+			// Adds delta to the size of segment
+			void add(size_type segment, difference_type delta) {
+				for (size_type i = segment + 1; i < m_tree.size(); i += i & (~i + 1))
+					m_tree[i] += delta;
+			}
+
+			// Number of elements in the segments before segment
+			size_type prefix(size_type segment) const {
+				size_type sum = 0;
+				for (size_type i = segment; i != 0; i &= i - 1)
+					sum += m_tree[i];
+				return sum;
+			}
+
+			// Segment and offset of the element of the given rank
+			std::pair<size_type, size_type> select(size_type rank) const {
+				size_type segment = 0;
+				size_type step = 1;
+				while (2 * step < m_tree.size())
+					step *= 2;
+				for (; step != 0; step /= 2) {
+					if (segment + step < m_tree.size() && m_tree[segment + step] <= rank) {
+						segment += step;
+						rank -= m_tree[segment];
+					}
+				}
+				return { segment, rank };
+			}
+
+			void clear() noexcept { m_tree.clear(); }
+			void reserve(size_type segments) { m_tree.reserve(segments + 1); }
+			void shrink_to_fit() { m_tree.shrink_to_fit(); }
+			void swap(fenwick_tree& other) noexcept { m_tree.swap(other.m_tree); }
+
+			size_type allocated_bytes() const noexcept { return vector_bytes(m_tree); }
+
+		};
+
+	}
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <memory>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+namespace libra {
+	namespace detail {
+
+		// Sequence stored in one allocation whose unused capacity forms a gap at the position
+		// of the last modification. Elements live in [first, gap_first) and [gap_last, last).
+		// Inserting or erasing at position i moves the gap there first, relocating only the
+		// elements between the old and the new gap position.
+		template <
+			class T,
+			class Allocator
+		> class gap_buffer {
+			static_assert(std::is_nothrow_move_constructible_v<T>,
+				"Relocating elements across the gap requires a non-throwing move constructor");
+		public:
+
+			using value_type      = T;
+			using allocator_type  = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+			using size_type       = std::size_t;
+			using difference_type = std::ptrdiff_t;
+			using pointer         = T*;
+			using const_pointer   = const T*;
+
+		private:
+
+			using alloc_traits = std::allocator_traits<allocator_type>;
+
+			allocator_type m_alloc;
+			pointer m_first = nullptr;
+			pointer m_gap_first = nullptr;
+			pointer m_gap_last = nullptr;
+			pointer m_last = nullptr;
+
+			// Move constructs count elements from src into the raw storage at dst and destroys
+			// the sources. Overlapping ranges are handled when dst > src by walking backwards.
+			void relocate(pointer src, size_type count, pointer dst) noexcept {
+				if (dst < src) {
+					for (size_type i = 0; i != count; ++i) {
+						alloc_traits::construct(m_alloc, dst + i, std::move(src[i]));
+						alloc_traits::destroy(m_alloc, src + i);
+					}
+				}
+				else {
+					for (size_type i = count; i-- != 0;) {
+						alloc_traits::construct(m_alloc, dst + i, std::move(src[i]));
+						alloc_traits::destroy(m_alloc, src + i);
+					}
+				}
+			}
+
+			void destroy_all() noexcept {
+				for (pointer p = m_first; p != m_gap_first; ++p)
+					alloc_traits::destroy(m_alloc, p);
+				for (pointer p = m_gap_last; p != m_last; ++p)
+					alloc_traits::destroy(m_alloc, p);
+			}
+
+			void deallocate() noexcept {
+				if (m_first)
+					alloc_traits::deallocate(m_alloc, m_first, capacity());
+				m_first = m_gap_first = m_gap_last = m_last = nullptr;
+			}
+
+			// Moves the elements into a new allocation of new_cap slots with the gap at pos
+			void reallocate(size_type new_cap, size_type pos) {
+				assert(new_cap >= size() && "Capacity below size!");
+				size_type n = size();
+				pointer first = alloc_traits::allocate(m_alloc, new_cap);
+				move_gap(pos);
+				size_type back = n - pos;
+				relocate(m_first, pos, first);
+				relocate(m_gap_last, back, first + new_cap - back);
+				deallocate();
+				m_first = first;
+				m_gap_first = first + pos;
+				m_gap_last = first + new_cap - back;
+				m_last = first + new_cap;
+			}
+
+		public:
+
+			gap_buffer() = default;
+
+			explicit gap_buffer(const Allocator& alloc)
+				: m_alloc(alloc) {}
+
+			gap_buffer(const gap_buffer& other)
+				: m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+			{
+				reserve(other.size());
+				for (size_type i = 0; i != other.size(); ++i)
+					emplace_back(other[i]);
+			}
+
+			gap_buffer(gap_buffer&& other) noexcept
+				: m_alloc(std::move(other.m_alloc))
+				, m_first(std::exchange(other.m_first, nullptr))
+				, m_gap_first(std::exchange(other.m_gap_first, nullptr))
+				, m_gap_last(std::exchange(other.m_gap_last, nullptr))
+				, m_last(std::exchange(other.m_last, nullptr)) {}
+
+			~gap_buffer() {
+				destroy_all();
+				deallocate();
+			}
+
+			gap_buffer& operator=(gap_buffer other) noexcept {
+				swap(other);
+				return *this;
+			}
+
+			allocator_type get_allocator() const noexcept { return m_alloc; }
+
+			// element access by logical position
+			T& operator[](size_type i) noexcept {
+				return i < front_size() ? m_first[i] : m_gap_last[i - front_size()];
+			}
+
+			const T& operator[](size_type i) const noexcept {
+				return i < front_size() ? m_first[i] : m_gap_last[i - front_size()];
+			}
+
+			// the contiguous runs before and after the gap
+			const_pointer front_data() const noexcept { return m_first; }
+			size_type front_size() const noexcept { return m_gap_first - m_first; }
+			const_pointer back_data() const noexcept { return m_gap_last; }
+			size_type back_size() const noexcept { return m_last - m_gap_last; }
+
+			// capacity
+			bool empty() const noexcept { return size() == 0; }
+			size_type size() const noexcept { return front_size() + back_size(); }
+			size_type max_size() const noexcept { return alloc_traits::max_size(m_alloc); }
+			size_type capacity() const noexcept { return m_last - m_first; }
+			size_type gap_position() const noexcept { return front_size(); }
+
+			void reserve(size_type new_cap) {
+				if (new_cap > capacity())
+					reallocate(new_cap, front_size());
+			}
+
+			void shrink_to_fit() {
+				if (size() == 0) {
+					deallocate();
+				}
+				else if (size() != capacity()) {
+					reallocate(size(), size());
+				}
+			}
+
+			// Moves the gap so that it starts at logical position pos
+			void move_gap(size_type pos) noexcept {
+				assert(pos <= size() && "Gap position out of range!");
+				size_type front = front_size();
+				if (m_gap_first == m_gap_last) {
+					// an empty gap moves without relocating anything
+					m_gap_first = m_gap_last = m_first + pos;
+				}
+				else if (pos < front) {
+					size_type count = front - pos;
+					relocate(m_first + pos, count, m_gap_last - count);
+					m_gap_first -= count;
+					m_gap_last -= count;
+				}
+				else if (pos > front) {
+					size_type count = pos - front;
+					relocate(m_gap_last, count, m_gap_first);
+					m_gap_first += count;
+					m_gap_last += count;
+				}
+			}
+
+			// modifiers
+			T& emplace(size_type pos, T&& value) {
+				if (m_gap_first == m_gap_last)
+					reallocate(std::max<size_type>(8, 2 * capacity()), pos);
+				else
+					move_gap(pos);
+				alloc_traits::construct(m_alloc, m_gap_first, std::move(value));
+				return *m_gap_first++;
+			}
+
+			template <class... Args>
+			void emplace_back(Args&&... args) {
+				if (m_gap_first == m_gap_last)
+					reallocate(std::max<size_type>(8, 2 * capacity()), size());
+				else
+					move_gap(size());
+				alloc_traits::construct(m_alloc, m_gap_first, std::forward<Args>(args)...);
+				++m_gap_first;
+			}
+
+			void erase(size_type pos, size_type count) noexcept {
+				assert(pos + count <= size() && "Erase out of range!");
+				move_gap(pos);
+				for (size_type i = 0; i != count; ++i)
+					alloc_traits::destroy(m_alloc, m_gap_last++);
+			}
+
+			void clear() noexcept {
+				destroy_all();
+				m_gap_first = m_first;
+				m_gap_last = m_last;
+			}
+
+			void swap(gap_buffer& other) noexcept {
+				std::swap(m_alloc, other.m_alloc);
+				std::swap(m_first, other.m_first);
+				std::swap(m_gap_first, other.m_gap_first);
+				std::swap(m_gap_last, other.m_gap_last);
+				std::swap(m_last, other.m_last);
+			}
+
+		};
+
+	}
+}
\ No newline at end of file
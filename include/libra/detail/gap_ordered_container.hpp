@@ -0,0 +1,599 @@
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include "gap_buffer.hpp"
+#include "sorted_tags.hpp"
+#include "is_transparent.hpp"
+#include "merge_appended.hpp"
+#include "ordered_container.hpp"
+#include "../algorithm/binary_search.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Random access iterator over a gap buffered container. It holds a logical position,
+		// so the gap is skipped transparently.
+		template <
+			class Container,
+			bool IsConst = false
+		> class gap_iterator {
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type        = typename Container::value_type;
+			using difference_type   = typename Container::difference_type;
+			using size_type         = typename Container::size_type;
+			using reference = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_reference,
+					typename Container::reference
+				>;
+			using pointer = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_pointer,
+					typename Container::pointer
+				>;
+
+			friend class gap_iterator<Container, !IsConst>;
+			friend Container;
+
+		private:
+
+			using container_pointer = std::conditional_t<IsConst, const Container*, Container*>;
+
+			container_pointer m_cont = nullptr;
+			size_type m_pos = 0;
+
+		public:
+
+			gap_iterator() = default;
+
+			gap_iterator(container_pointer cont, size_type pos)
+				: m_cont(cont), m_pos(pos) {}
+
+			// non const to const iterator
+			template <bool is_const = IsConst, class = std::enable_if_t<is_const>>
+			gap_iterator(const gap_iterator<Container, false>& it)
+				: m_cont(it.m_cont), m_pos(it.m_pos) {}
+
+			// difference operator
+
+			template <bool is_const>
+			difference_type operator-(const gap_iterator<Container, is_const>& it) const noexcept {
+				return static_cast<difference_type>(m_pos) - static_cast<difference_type>(it.m_pos);
+			}
+
+			// pointer-like operators
+
+			reference operator*() const {
+				assert(m_pos < m_cont->size() && "Iterator not dereferenceable!");
+				return m_cont->m_data[m_pos];
+			}
+
+			pointer operator->() const {
+				return std::addressof(**this);
+			}
+
+			reference operator[](difference_type n) const {
+				return *(*this + n);
+			}
+
+			// increment / decrement
+
+			gap_iterator& operator++() noexcept { ++m_pos; return *this; }
+			gap_iterator operator++(int) noexcept { gap_iterator tmp(*this); ++*this; return tmp; }
+
+			gap_iterator& operator--() noexcept { --m_pos; return *this; }
+			gap_iterator operator--(int) noexcept { gap_iterator tmp(*this); --*this; return tmp; }
+
+			// arithmetic
+
+			gap_iterator& operator+=(difference_type n) noexcept { m_pos += n; return *this; }
+			gap_iterator operator+(difference_type n) const noexcept { return gap_iterator(*this) += n; }
+			friend gap_iterator operator+(difference_type n, const gap_iterator& it) noexcept { return it + n; }
+
+			gap_iterator& operator-=(difference_type n) noexcept { m_pos -= n; return *this; }
+			gap_iterator operator-(difference_type n) const noexcept { return gap_iterator(*this) -= n; }
+
+			// comparison
+
+			template <bool is_const>
+			bool operator==(const gap_iterator<Container, is_const>& it) const noexcept { return m_pos == it.m_pos; }
+
+			template <bool is_const>
+			bool operator!=(const gap_iterator<Container, is_const>& it) const noexcept { return m_pos != it.m_pos; }
+
+			template <bool is_const>
+			bool operator<(const gap_iterator<Container, is_const>& it) const noexcept { return m_pos < it.m_pos; }
+
+			template <bool is_const>
+			bool operator<=(const gap_iterator<Container, is_const>& it) const noexcept { return m_pos <= it.m_pos; }
+
+			template <bool is_const>
+			bool operator>(const gap_iterator<Container, is_const>& it) const noexcept { return m_pos > it.m_pos; }
+
+			template <bool is_const>
+			bool operator>=(const gap_iterator<Container, is_const>& it) const noexcept { return m_pos >= it.m_pos; }
+
+		};
+
+		// Sorted container of unique keys kept in a gap buffer. The unused capacity sits at
+		// the position of the last insertion or erasure, so a run of modifications around a
+		// moving frontier only relocates the elements between consecutive positions instead
+		// of everything after the insertion point. Lookups search the contiguous runs on
+		// either side of the gap with the array kernels.
+		template <
+			class Value,
+			class Compare,
+			class Allocator,
+			class ExtractKey
+		> class gap_ordered_container {
+		public:
+
+			using container_type         = std::vector<Value, Allocator>;
+			using storage_type           = gap_buffer<Value, Allocator>;
+			using key_type               = typename ExtractKey::type;
+			using value_type             = Value;
+			using size_type              = typename storage_type::size_type;
+			using difference_type        = typename storage_type::difference_type;
+			using key_compare            = Compare;
+			using value_compare          = ValueCompare<Value, Compare, ExtractKey>;
+			using allocator_type         = Allocator;
+			using reference              = Value&;
+			using const_reference        = const Value&;
+			using pointer                = Value*;
+			using const_pointer          = const Value*;
+			using iterator               = gap_iterator<gap_ordered_container>;
+			using const_iterator         = gap_iterator<gap_ordered_container, true>;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			friend iterator;
+			friend const_iterator;
+
+		private:
+
+			key_compare m_key_cmp;
+			value_compare m_val_cmp;
+			ExtractKey m_extract;
+			storage_type m_data;
+
+			bool iterator_in_range(const_iterator it) const {
+				return cbegin() <= it && it <= cend();
+			}
+
+			template <class K1, class K2>
+			bool equivalent(const K1& lhs, const K2& rhs) const {
+				return !m_key_cmp(lhs, rhs) && !m_key_cmp(rhs, lhs);
+			}
+
+			// Position of the lower bound of key, or of its upper bound when Upper. Only one
+			// of the runs around the gap is searched.
+			template <bool Upper, class Key>
+			size_type bound_index(const Key& key) const {
+				const_pointer front = m_data.front_data();
+				size_type front_size = m_data.front_size();
+				if (front_size != 0) {
+					const auto& last_key = m_extract(front[front_size - 1]);
+					if (Upper ? m_key_cmp(key, last_key) : !m_key_cmp(last_key, key)) {
+						if constexpr (Upper)
+							return detail::upper_bound(front, front + front_size, key, m_key_cmp, m_extract) - front;
+						else
+							return detail::lower_bound(front, front + front_size, key, m_key_cmp, m_extract) - front;
+					}
+				}
+				const_pointer back = m_data.back_data();
+				size_type back_size = m_data.back_size();
+				if constexpr (Upper)
+					return front_size + (detail::upper_bound(back, back + back_size, key, m_key_cmp, m_extract) - back);
+				else
+					return front_size + (detail::lower_bound(back, back + back_size, key, m_key_cmp, m_extract) - back);
+			}
+
+			template <class Key>
+			size_type find_index(const Key& key) const {
+				size_type idx = bound_index<false>(key);
+				return idx != size() && equivalent(m_extract(m_data[idx]), key) ? idx : size();
+			}
+
+			// Places value at idx unless an element with an equivalent key is there
+			std::pair<iterator, bool> insert_at(size_type idx, value_type&& value) {
+				if (idx != size() && equivalent(m_extract(m_data[idx]), m_extract(value)))
+					return { begin() + idx, false };
+				m_data.emplace(idx, std::move(value));
+				return { begin() + idx, true };
+			}
+
+			// Rebuilds the storage from the sorted elements followed by the unsorted range
+			template <bool Sorted, class InIt>
+			void insert_range(InIt first, InIt last) {
+				container_type data(get_allocator());
+				data.reserve(size());
+				for (size_type i = 0; i != size(); ++i)
+					data.emplace_back(std::move(m_data[i]));
+				auto n = data.size();
+				data.insert(data.end(), first, last);
+				merge_appended<false, Sorted>(data, n, m_val_cmp);
+				assign(std::move(data));
+			}
+
+			void assign(container_type&& data) {
+				storage_type storage(get_allocator());
+				storage.reserve(data.size());
+				for (auto& value : data)
+					storage.emplace_back(std::move(value));
+				m_data = std::move(storage);
+			}
+
+		public:
+
+			// ctor
+			gap_ordered_container()
+				: gap_ordered_container(Compare(), Allocator()) {}
+
+			explicit gap_ordered_container(const Compare& comp, const Allocator& alloc = Allocator())
+				: m_key_cmp(comp)
+				, m_val_cmp(comp)
+				, m_extract()
+				, m_data(alloc) {}
+
+			explicit gap_ordered_container(const Allocator& alloc)
+				: gap_ordered_container(Compare(), alloc) {}
+
+			template <class InIt>
+			gap_ordered_container(InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: gap_ordered_container(comp, alloc)
+			{
+				insert(first, last);
+			}
+
+			template <class InIt>
+			gap_ordered_container(InIt first, InIt last,
+				const Allocator& alloc)
+				: gap_ordered_container(first, last, Compare(), alloc) {}
+
+			template <class InIt>
+			gap_ordered_container(sorted_unique_t tag, InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: gap_ordered_container(comp, alloc)
+			{
+				insert(tag, first, last);
+			}
+
+			template <class InIt>
+			gap_ordered_container(sorted_unique_t tag, InIt first, InIt last,
+				const Allocator& alloc)
+				: gap_ordered_container(tag, first, last, Compare(), alloc) {}
+
+			gap_ordered_container(const gap_ordered_container&) = default;
+			gap_ordered_container(gap_ordered_container&&) = default;
+
+			gap_ordered_container(std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: gap_ordered_container(list.begin(), list.end(), comp, alloc) {}
+
+			gap_ordered_container(std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: gap_ordered_container(list, Compare(), alloc) {}
+
+			gap_ordered_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: gap_ordered_container(tag, list.begin(), list.end(), comp, alloc) {}
+
+			gap_ordered_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: gap_ordered_container(tag, list, Compare(), alloc) {}
+
+			// dtor
+			~gap_ordered_container() = default;
+
+			// assignment
+			gap_ordered_container& operator=(const gap_ordered_container&) = default;
+			gap_ordered_container& operator=(gap_ordered_container&&) = default;
+			gap_ordered_container& operator=(std::initializer_list<value_type> list) {
+				clear();
+				insert(list);
+				return *this;
+			}
+
+			allocator_type get_allocator() const noexcept { return allocator_type(m_data.get_allocator()); }
+
+			// iterators
+			iterator begin() noexcept { return iterator(this, 0); }
+			const_iterator begin() const noexcept { return const_iterator(this, 0); }
+			const_iterator cbegin() const noexcept { return begin(); }
+
+			iterator end() noexcept { return iterator(this, size()); }
+			const_iterator end() const noexcept { return const_iterator(this, size()); }
+			const_iterator cend() const noexcept { return end(); }
+
+			reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+			// capacity
+			bool empty() const noexcept { return m_data.empty(); }
+			size_type size() const noexcept { return m_data.size(); }
+			size_type max_size() const noexcept { return m_data.max_size(); }
+			size_type capacity() const noexcept { return m_data.capacity(); }
+			void reserve(size_type new_cap) { m_data.reserve(new_cap); }
+			void shrink_to_fit() { m_data.shrink_to_fit(); }
+
+			// memory, see libra::memory_footprint
+			size_type allocated_bytes() const noexcept {
+				return m_data.capacity() * sizeof(value_type);
+			}
+
+			size_type wasted_capacity() const noexcept {
+				return allocated_bytes() - size() * sizeof(value_type);
+			}
+
+			memory_footprint memory_usage() const {
+				return make_footprint(allocated_bytes(), size() * sizeof(value_type), begin(), end());
+			}
+
+			// Position of the gap, where the last insertion or erasure happened
+			size_type gap_position() const noexcept { return m_data.gap_position(); }
+
+			// modifiers
+			void clear() noexcept { m_data.clear(); }
+
+			std::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+			std::pair<iterator, bool> insert(value_type&& value) { return emplace(std::move(value)); }
+
+			iterator insert(const_iterator hint, const value_type& value) { return emplace_hint(hint, value); }
+			iterator insert(const_iterator hint, value_type&& value) { return emplace_hint(hint, std::move(value)); }
+
+			template <class InIt>
+			void insert(InIt first, InIt last) {
+				insert_range<false>(first, last);
+			}
+
+			void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+			template <class InIt>
+			void insert(sorted_unique_t, InIt first, InIt last) {
+				insert_range<true>(first, last);
+			}
+
+			void insert(sorted_unique_t tag, std::initializer_list<value_type> list) {
+				insert(tag, list.begin(), list.end());
+			}
+
+			template <class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args) {
+				value_type value(std::forward<Args>(args)...);
+				return insert_at(bound_index<false>(m_extract(value)), std::move(value));
+			}
+
+			template <class... Args>
+			iterator emplace_hint(const_iterator hint, Args&&... args) {
+				assert(iterator_in_range(hint) && "Iterator out of range!");
+				value_type value(std::forward<Args>(args)...);
+				const auto& key = m_extract(value);
+				size_type pos = hint.m_pos;
+				// a correct hint needs no search
+				if ((pos == size() || m_key_cmp(key, m_extract(m_data[pos])))
+					&& (pos == 0 || m_key_cmp(m_extract(m_data[pos - 1]), key)))
+					return insert_at(pos, std::move(value)).first;
+				return insert_at(bound_index<false>(key), std::move(value)).first;
+			}
+
+			iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+			iterator erase(const_iterator first, const_iterator last) {
+				m_data.erase(first.m_pos, last - first);
+				return begin() + first.m_pos;
+			}
+
+			size_type erase(const key_type& key) {
+				auto it = find(key);
+				if (it == end())
+					return 0;
+				erase(it);
+				return 1;
+			}
+
+			// Moves the elements out of the container into a sorted array, leaving it empty
+			container_type extract() && {
+				container_type data(get_allocator());
+				data.reserve(size());
+				for (size_type i = 0; i != size(); ++i)
+					data.emplace_back(std::move(m_data[i]));
+				clear();
+				return data;
+			}
+
+			// Adopts the elements of a sorted array of unique elements
+			void replace(container_type&& data) {
+				assert(std::adjacent_find(data.begin(), data.end(), [this](const value_type& lhs, const value_type& rhs) {
+					return !m_val_cmp(lhs, rhs);
+				}) == data.end() && "Storage is not sorted!");
+				assign(std::move(data));
+			}
+
+			void swap(gap_ordered_container& other)
+				noexcept(std::is_nothrow_swappable<Compare>::value)
+			{
+				if (this != &other) {
+					std::swap(m_key_cmp, other.m_key_cmp);
+					std::swap(m_val_cmp, other.m_val_cmp);
+					std::swap(m_extract, other.m_extract);
+					m_data.swap(other.m_data);
+				}
+			}
+
+			// lookup
+			size_type count(const key_type& key) const {
+				return contains(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, size_type>
+				count(const K& key) const {
+				return contains(key);
+			}
+
+			iterator find(const key_type& key) {
+				return begin() + find_index(key);
+			}
+
+			const_iterator find(const key_type& key) const {
+				return begin() + find_index(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				find(const K& key) {
+				return begin() + find_index(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				find(const K& key) const {
+				return begin() + find_index(key);
+			}
+
+			bool contains(const key_type& key) const {
+				return find_index(key) != size();
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, bool>
+				contains(const K& key) const {
+				return find_index(key) != size();
+			}
+
+			std::pair<iterator, iterator> equal_range(const key_type& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<iterator, iterator>>
+				equal_range(const K& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<const_iterator, const_iterator>>
+				equal_range(const K& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			iterator lower_bound(const key_type& key) {
+				return begin() + bound_index<false>(key);
+			}
+
+			const_iterator lower_bound(const key_type& key) const {
+				return begin() + bound_index<false>(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				lower_bound(const K& key) {
+				return begin() + bound_index<false>(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				lower_bound(const K& key) const {
+				return begin() + bound_index<false>(key);
+			}
+
+			iterator upper_bound(const key_type& key) {
+				return begin() + bound_index<true>(key);
+			}
+
+			const_iterator upper_bound(const key_type& key) const {
+				return begin() + bound_index<true>(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				upper_bound(const K& key) {
+				return begin() + bound_index<true>(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				upper_bound(const K& key) const {
+				return begin() + bound_index<true>(key);
+			}
+
+			// observers
+			key_compare key_comp() const { return m_key_cmp; }
+			value_compare value_comp() const { return m_val_cmp; }
+
+		};
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator==(
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			auto comp = lhs.value_comp();
+			auto equal = [&comp](const Value& lhs, const Value& rhs) {
+				return !comp(lhs, rhs) && !comp(rhs, lhs);
+			};
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), equal);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator!=(
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<(
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lhs.value_comp());
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<=(
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>(
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return rhs < lhs;
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>=(
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const gap_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs < rhs);
+		}
+
+	}
+}
\ No newline at end of file
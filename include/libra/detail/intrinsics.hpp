@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#if !defined(LIBRA_NO_SIMD) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define LIBRA_X86_SIMD 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define LIBRA_TARGET_AVX2
+#else
+#include <immintrin.h>
+#define LIBRA_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace libra {
+	namespace detail {
+
+		// Whether the call happens during constant evaluation. Conservatively
+		// reports true when the compiler offers no way of telling.
+		constexpr bool is_constant_evaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+			return std::is_constant_evaluated();
+#elif defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+			return __builtin_is_constant_evaluated();
+#else
+			return true;
+#endif
+		}
+
+		// Hints the processor to pull the cache line holding p into all cache levels
+		inline void prefetch(const void* p) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+			(void)p;
+#endif
+		}
+
+		inline int popcount(std::uint32_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_popcount(mask);
+#else
+			int count = 0;
+			for (; mask != 0; mask &= mask - 1)
+				++count;
+			return count;
+#endif
+		}
+
+		// Number of trailing zero bits of a non-zero mask
+		inline int countr_zero(std::uint64_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(mask);
+#else
+			int count = 0;
+			for (; (mask & 1) == 0; mask >>= 1)
+				++count;
+			return count;
+#endif
+		}
+
+		// Number of leading zero bits of a non-zero mask
+		inline int countl_zero(std::uint64_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_clzll(mask);
+#else
+			int count = 0;
+			for (; (mask & (std::uint64_t(1) << 63)) == 0; mask <<= 1)
+				++count;
+			return count;
+#endif
+		}
+
+		// Number of trailing one bits of a mask that is not all ones
+		inline int countr_one(std::uint64_t mask) noexcept {
+			return detail::countr_zero(~mask);
+		}
+
+#if defined(LIBRA_X86_SIMD)
+		// Whether the processor and the operating system support AVX2, checked once
+		inline bool cpu_supports_avx2() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+			static const bool supported = [] {
+				int info[4];
+				__cpuid(info, 0);
+				if (info[0] < 7)
+					return false;
+				__cpuid(info, 1);
+				bool os_saves_ymm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+				__cpuidex(info, 7, 0);
+				return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+			}();
+#else
+			static const bool supported = __builtin_cpu_supports("avx2");
+#endif
+			return supported;
+		}
+#endif
+
+	}
+}
\ No newline at end of file
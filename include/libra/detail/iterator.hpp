@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include <iterator>
 #include <type_traits>
 
@@ -20,5 +21,25 @@ namespace libra {
 			class It
 		> constexpr bool is_iterator_v = is_iterator<It>::value;
 
+		// Raw pointers and std::vector iterators over scalars are known to address contiguous storage
+		template <
+			class It,
+			class = void
+		> struct is_contiguous_iterator : std::is_pointer<It> {};
+
+		template <
+			class It
+		> struct is_contiguous_iterator<It, std::enable_if_t<!std::is_pointer_v<It>
+			&& std::is_scalar_v<typename std::iterator_traits<It>::value_type>
+			&& !std::is_same_v<typename std::iterator_traits<It>::value_type, bool>>>
+			: std::bool_constant<
+				std::is_same_v<It, typename std::vector<typename std::iterator_traits<It>::value_type>::iterator>
+				|| std::is_same_v<It, typename std::vector<typename std::iterator_traits<It>::value_type>::const_iterator>
+			> {};
+
+		template <
+			class It
+		> constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<It>::value;
+
 	}
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace libra {
+
+	// Heap memory held by a container, as reported by its memory_usage()
+	struct memory_footprint {
+		std::size_t allocated_bytes = 0; // storage the container allocated itself
+		std::size_t used_bytes = 0; // part of allocated_bytes holding live elements
+		std::size_t element_bytes = 0; // storage owned by the elements, see heap_bytes
+
+		// Slack capacity plus bookkeeping such as indexes and counters
+		std::size_t wasted_bytes() const noexcept { return allocated_bytes - used_bytes; }
+		std::size_t total_bytes() const noexcept { return allocated_bytes + element_bytes; }
+
+		memory_footprint& operator+=(const memory_footprint& other) noexcept {
+			allocated_bytes += other.allocated_bytes;
+			used_bytes += other.used_bytes;
+			element_bytes += other.element_bytes;
+			return *this;
+		}
+
+		friend memory_footprint operator+(memory_footprint lhs, const memory_footprint& rhs) noexcept {
+			return lhs += rhs;
+		}
+	};
+
+	namespace detail {
+		struct no_heap_bytes {};
+	}
+
+	// Customization point reporting the heap memory owned by a T. Specialize it with a
+	// static bytes(const T&) for element types that allocate. Elements without a
+	// specialization are not visited, so memory_usage() stays O(1) in the element count.
+	template <class T>
+	struct heap_bytes : detail::no_heap_bytes {
+		static std::size_t bytes(const T&) noexcept { return 0; }
+	};
+
+	namespace detail {
+
+		template <class T>
+		constexpr bool has_heap_bytes_v = !std::is_base_of_v<no_heap_bytes, heap_bytes<T>>;
+
+		// Heap memory owned by the elements of [first, last)
+		template <class InIt>
+		std::size_t element_heap_bytes(InIt first, InIt last) {
+			using value_type = typename std::iterator_traits<InIt>::value_type;
+			std::size_t bytes = 0;
+			if constexpr (has_heap_bytes_v<value_type>) {
+				for (; first != last; ++first)
+					bytes += heap_bytes<value_type>::bytes(*first);
+			}
+			return bytes;
+		}
+
+		template <class Vector>
+		std::size_t vector_bytes(const Vector& vec) noexcept {
+			return vec.capacity() * sizeof(typename Vector::value_type);
+		}
+
+		template <class InIt>
+		memory_footprint make_footprint(std::size_t allocated, std::size_t used, InIt first, InIt last) {
+			memory_footprint usage;
+			usage.allocated_bytes = allocated;
+			usage.used_bytes = used;
+			usage.element_bytes = element_heap_bytes(first, last);
+			return usage;
+		}
+
+		struct some_heap_bytes {};
+
+	}
+
+	template <class Char, class Traits, class Allocator>
+	struct heap_bytes<std::basic_string<Char, Traits, Allocator>> {
+		static std::size_t bytes(const std::basic_string<Char, Traits, Allocator>& str) noexcept {
+			// capacities up to that of an empty string fit in the small string buffer
+			std::size_t small = std::basic_string<Char, Traits, Allocator>().capacity();
+			return str.capacity() > small ? (str.capacity() + 1) * sizeof(Char) : 0;
+		}
+	};
+
+	template <class T, class Allocator>
+	struct heap_bytes<std::vector<T, Allocator>> {
+		static std::size_t bytes(const std::vector<T, Allocator>& vec) noexcept {
+			return detail::vector_bytes(vec) + detail::element_heap_bytes(vec.begin(), vec.end());
+		}
+	};
+
+	template <class T1, class T2>
+	struct heap_bytes<std::pair<T1, T2>>
+		: std::conditional_t<
+			detail::has_heap_bytes_v<std::remove_const_t<T1>> || detail::has_heap_bytes_v<T2>,
+			detail::some_heap_bytes,
+			detail::no_heap_bytes
+		>
+	{
+		static std::size_t bytes(const std::pair<T1, T2>& p) noexcept {
+			return heap_bytes<std::remove_const_t<T1>>::bytes(p.first) + heap_bytes<T2>::bytes(p.second);
+		}
+	};
+
+	// Process-wide count of the memory allocated through tracking_allocator<T, Tag>.
+	// Distinct tags keep separate totals.
+	template <class Tag = void>
+	class memory_tracker {
+		static inline std::atomic<std::size_t> s_live_bytes{ 0 };
+		static inline std::atomic<std::size_t> s_peak_bytes{ 0 };
+		static inline std::atomic<std::size_t> s_allocations{ 0 };
+
+	public:
+
+		static std::size_t live_bytes() noexcept { return s_live_bytes.load(std::memory_order_relaxed); }
+		static std::size_t peak_bytes() noexcept { return s_peak_bytes.load(std::memory_order_relaxed); }
+		static std::size_t allocations() noexcept { return s_allocations.load(std::memory_order_relaxed); }
+
+		static void on_allocate(std::size_t bytes) noexcept {
+			s_allocations.fetch_add(1, std::memory_order_relaxed);
+			std::size_t live = s_live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+			std::size_t peak = s_peak_bytes.load(std::memory_order_relaxed);
+			while (peak < live && !s_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed));
+		}
+
+		static void on_deallocate(std::size_t bytes) noexcept {
+			s_live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+		}
+
+		// Restarts the peak from the current live bytes
+		static void reset_peak() noexcept {
+			s_peak_bytes.store(live_bytes(), std::memory_order_relaxed);
+		}
+	};
+
+	// std::allocator reporting every allocation to memory_tracker<Tag>
+	template <class T, class Tag = void>
+	class tracking_allocator {
+	public:
+
+		using value_type = T;
+
+		tracking_allocator() noexcept = default;
+
+		template <class U>
+		tracking_allocator(const tracking_allocator<U, Tag>&) noexcept {}
+
+		T* allocate(std::size_t n) {
+			T* p = std::allocator<T>().allocate(n);
+			memory_tracker<Tag>::on_allocate(n * sizeof(T));
+			return p;
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept {
+			memory_tracker<Tag>::on_deallocate(n * sizeof(T));
+			std::allocator<T>().deallocate(p, n);
+		}
+
+		template <class U>
+		friend bool operator==(const tracking_allocator&, const tracking_allocator<U, Tag>&) noexcept { return true; }
+
+		template <class U>
+		friend bool operator!=(const tracking_allocator&, const tracking_allocator<U, Tag>&) noexcept { return false; }
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+
+namespace libra {
+	namespace detail {
+
+		// Merges the elements appended to data past the first n into the sorted prefix,
+		// sorting them first unless Sorted. Without AllowDuplicates an element equivalent to
+		// an earlier one is dropped, so the prefix wins over the appended elements. Returns the
+		// number of element moves made by the sort and the merge, counting each element they
+		// span once.
+		template <bool AllowDuplicates, bool Sorted, class Container, class Compare>
+		std::size_t merge_appended(Container& data, typename Container::size_type n, Compare comp) {
+			std::size_t moves = 0;
+			auto middle = data.begin() + n;
+			if constexpr (!Sorted) {
+				if (!std::is_sorted(middle, data.end(), comp)) {
+					std::stable_sort(middle, data.end(), comp);
+					moves += data.end() - middle;
+				}
+			}
+			if constexpr (AllowDuplicates) {
+				if (middle == data.end() || middle == data.begin() || !comp(*middle, *std::prev(middle)))
+					return moves;
+				std::inplace_merge(data.begin(), middle, data.end(), comp);
+				moves += data.size();
+			}
+			else {
+				auto equivalent = [&comp](const auto& lhs, const auto& rhs) {
+					return !comp(lhs, rhs);
+				};
+				data.erase(std::unique(middle, data.end(), equivalent), data.end());
+				middle = data.begin() + n;
+				if (middle == data.end() || middle == data.begin() || comp(*std::prev(middle), *middle))
+					return moves;
+				std::inplace_merge(data.begin(), middle, data.end(), comp);
+				moves += data.size();
+				data.erase(std::unique(data.begin(), data.end(), equivalent), data.end());
+			}
+			return moves;
+		}
+
+	}
+}
@@ -3,7 +3,13 @@
 #include <vector>
 #include <cassert>
 #include <algorithm>
+#include "sorted_tags.hpp"
 #include "is_transparent.hpp"
+#include "static_index.hpp"
+#include "search_policy.hpp"
+#include "stats_policy.hpp"
+#include "memory_usage.hpp"
+#include "merge_appended.hpp"
 #include "../algorithm/binary_search.hpp"
 
 namespace libra {
@@ -51,11 +57,15 @@ namespace libra {
 			class Compare,
 			class Allocator,
 			class ExtractKey,
-			bool AllowDuplicates
-		> class ordered_container {
-			using container_type = std::vector<Value, Allocator>;
+			bool AllowDuplicates,
+			class SearchPolicy = binary_search_policy,
+			class Stats = no_stats
+		> class ordered_container
+			: private stats_holder<Stats>
+		{
 		public:
 
+			using container_type         = std::vector<Value, Allocator>;
 			using key_type               = typename ExtractKey::type;
 			using value_type             = typename container_type::value_type;
 			using size_type              = typename container_type::size_type;
@@ -73,6 +83,12 @@ namespace libra {
 			using reverse_iterator       = typename container_type::reverse_iterator;
 			using const_reverse_iterator = typename container_type::const_reverse_iterator;
 
+			// Insert position found by insert_check, valid until the container is next modified
+			class insert_commit_data {
+				friend class ordered_container;
+				size_type m_position = 0;
+			};
+
 		private:
 
 			key_compare m_key_cmp;
@@ -80,26 +96,83 @@ namespace libra {
 			key_equal m_equal;
 			ExtractKey m_extract;
 			container_type m_data;
+			static_index<key_type, Compare, Allocator> m_index;
 
 			using emplace_return_type = std::conditional_t<AllowDuplicates, iterator, std::pair<iterator, bool>>;
+			using sorted_tag_type = std::conditional_t<AllowDuplicates, sorted_equivalent_t, sorted_unique_t>;
+
+			// The comparators, reporting to the stats policy when it records anything
+			decltype(auto) key_cmp() const {
+				if constexpr (records_stats_v<Stats>)
+					return observed_compare<key_compare, Stats>(m_key_cmp, this->observer());
+				else
+					return (m_key_cmp);
+			}
+
+			decltype(auto) val_cmp() const {
+				if constexpr (records_stats_v<Stats>)
+					return observed_compare<value_compare, Stats>(m_val_cmp, this->observer());
+				else
+					return (m_val_cmp);
+			}
+
+			decltype(auto) equal() const {
+				if constexpr (records_stats_v<Stats>)
+					return observed_compare<key_equal, Stats, 2>(m_equal, this->observer());
+				else
+					return (m_equal);
+			}
+
+			// Reports the reallocation of the storage if its capacity changed from cap
+			void note_capacity(size_type cap, size_type moved) {
+				if (m_data.capacity() != cap && m_data.capacity() != 0) {
+					this->observer().on_allocate(m_data.capacity() * sizeof(value_type));
+					this->observer().on_move(moved);
+				}
+			}
+
+			template <class... Args>
+			void append(Args&& ...args) {
+				size_type cap = m_data.capacity();
+				m_data.emplace_back(std::forward<Args>(args)...);
+				note_capacity(cap, size() - 1);
+			}
+
+			void rotate(iterator first, iterator middle, iterator last) {
+				this->observer().on_rotate(last - first);
+				this->observer().on_move(last - first);
+				std::rotate(first, middle, last);
+			}
 
 			bool iterator_in_range(const_iterator it) const {
 				return cbegin() <= it && it <= cend();
 			}
 
+			bool range_in_order(const_iterator first, const_iterator last) const {
+				if constexpr (AllowDuplicates) {
+					return std::is_sorted(first, last, val_cmp());
+				}
+				else {
+					auto out_of_order = [this](const value_type& lhs, const value_type& rhs) {
+						return !val_cmp()(lhs, rhs);
+					};
+					return std::adjacent_find(first, last, out_of_order) == last;
+				}
+			}
+
 			template <class... Args>
 			std::pair<iterator, bool> emplace_unique(Args&& ...args) {
-				m_data.emplace_back(std::forward<Args>(args)...);
+				append(std::forward<Args>(args)...);
 				auto last = std::prev(end());
-				auto lower = detail::lower_bound(begin(), last, m_extract(*last), m_key_cmp, m_extract);
+				auto lower = detail::lower_bound(begin(), last, m_extract(*last), key_cmp(), m_extract);
 				if (lower == last)
 					return { lower, true };
-				else if (m_equal(m_extract(*lower), m_extract(*last))) {
+				else if (equal()(m_extract(*lower), m_extract(*last))) {
 					m_data.pop_back();
 					return { lower, false };
 				}
 				else {
-					std::rotate(lower, last, end());
+					rotate(lower, last, end());
 					return { lower, true };
 				}
 			}
@@ -109,43 +182,43 @@ namespace libra {
 				assert(iterator_in_range(hint) && "Iterator out of range!");
 
 				difference_type step = hint - cbegin();
-				m_data.emplace_back(std::forward<Args>(args)...);
+				append(std::forward<Args>(args)...);
 
 				iterator pos = begin() + step;
 				iterator last = std::prev(end());
 
-				if (pos == last || m_val_cmp(*last, *pos)) {
-					if (pos == begin() || m_val_cmp(*std::prev(pos), *last)) {
-						std::rotate(pos, last, end());
+				if (pos == last || val_cmp()(*last, *pos)) {
+					if (pos == begin() || val_cmp()(*std::prev(pos), *last)) {
+						rotate(pos, last, end());
 						return pos;
 					}
 					iterator prev = std::prev(pos);
-					if (m_equal(m_extract(*prev), m_extract(*last))) {
+					if (equal()(m_extract(*prev), m_extract(*last))) {
 						m_data.pop_back();
 						return prev;
 					}
 					else {
-						auto lower = detail::lower_bound(begin(), prev, m_extract(*last), m_key_cmp, m_extract);
-						if (m_equal(m_extract(*lower), m_extract(*last))) {
+						auto lower = detail::lower_bound(begin(), prev, m_extract(*last), key_cmp(), m_extract);
+						if (equal()(m_extract(*lower), m_extract(*last))) {
 							m_data.pop_back();
 							return lower;
 						}
 						else {
-							std::rotate(lower, last, end());
+							rotate(lower, last, end());
 							return lower;
 						}
 					}
 				}
 				else {
-					auto lower = detail::lower_bound(pos, last, m_extract(*last), m_key_cmp, m_extract);
+					auto lower = detail::lower_bound(pos, last, m_extract(*last), key_cmp(), m_extract);
 					if (lower == last)
 						return lower;
-					else if (m_equal(m_extract(*lower), m_extract(*last))) {
+					else if (equal()(m_extract(*lower), m_extract(*last))) {
 						m_data.pop_back();
 						return lower;
 					}
 					else {
-						std::rotate(lower, last, end());
+						rotate(lower, last, end());
 						return lower;
 					}
 				}
@@ -153,9 +226,9 @@ namespace libra {
 
 			template <class... Args>
 			iterator emplace_common(Args&& ...args) {
-				m_data.emplace_back(std::forward<Args>(args)...);
-				auto upper = detail::upper_bound(begin(), std::prev(end()), m_extract(m_data.back()), m_key_cmp, m_extract);
-				std::rotate(upper, std::prev(end()), end());
+				append(std::forward<Args>(args)...);
+				auto upper = detail::upper_bound(begin(), std::prev(end()), m_extract(m_data.back()), key_cmp(), m_extract);
+				rotate(upper, std::prev(end()), end());
 				return upper;
 			}
 
@@ -164,32 +237,92 @@ namespace libra {
 				assert(iterator_in_range(hint) && "Iterator out of range!");
 
 				difference_type step = hint - cbegin();
-				m_data.emplace_back(std::forward<Args>(args)...);
+				append(std::forward<Args>(args)...);
 
 				iterator pos = begin() + step;
 				iterator last = std::prev(end());
 
-				if (pos == last || m_val_cmp(*last, *pos)) {
+				if (pos == last || val_cmp()(*last, *pos)) {
 					if (pos == begin() 
-						|| m_val_cmp(*std::prev(pos), *last) 
-						|| m_equal(m_extract(*std::prev(pos)), m_extract(*last))) 
+						|| val_cmp()(*std::prev(pos), *last) 
+						|| equal()(m_extract(*std::prev(pos)), m_extract(*last))) 
 					{
-						std::rotate(pos, last, end());
+						rotate(pos, last, end());
 						return pos;
 					}
 					else {
-						auto upper = detail::upper_bound(begin(), std::prev(pos), m_extract(*last), m_key_cmp, m_extract);
-						std::rotate(upper, last, end());
+						auto upper = detail::upper_bound(begin(), std::prev(pos), m_extract(*last), key_cmp(), m_extract);
+						rotate(upper, last, end());
 						return upper;
 					}
 				}
 				else {
-					auto upper = detail::upper_bound(pos, last, m_extract(*last), m_key_cmp, m_extract);
-					std::rotate(upper, last, end());
+					auto upper = detail::upper_bound(pos, last, m_extract(*last), key_cmp(), m_extract);
+					rotate(upper, last, end());
 					return upper;
 				}
 			}
 
+			// Rebuilds the static index after a modification of a frozen container
+			void sync_index() {
+				if (m_index.enabled())
+					m_index.build(m_data.data(), m_data.size(), m_extract);
+			}
+
+			template <class Key>
+			size_type lower_index(const Key& key) const {
+				if (m_index.enabled())
+					return m_index.template bound<false>(m_data.data(), m_data.size(), key, m_key_cmp, m_extract);
+				return SearchPolicy().lower_bound(cbegin(), cend(), key, key_cmp(), m_extract) - cbegin();
+			}
+
+			template <class Key>
+			size_type upper_index(const Key& key) const {
+				if (m_index.enabled())
+					return m_index.template bound<true>(m_data.data(), m_data.size(), key, m_key_cmp, m_extract);
+				return SearchPolicy().upper_bound(cbegin(), cend(), key, key_cmp(), m_extract) - cbegin();
+			}
+
+			// Gallops from hint, see libra::exponential_search
+			template <bool Upper, class Key>
+			size_type bound_index(const_iterator hint, const Key& key) const {
+				return detail::exponential_bound<Upper>(cbegin(), hint, cend(), key, key_cmp(), m_extract) - cbegin();
+			}
+
+			// Reports the element equivalent to key in a unique container, or else records
+			// pos as the place to insert it
+			template <class Key>
+			std::pair<iterator, bool> check_position(size_type pos, const Key& key, insert_commit_data& data) {
+				if constexpr (!AllowDuplicates) {
+					if (pos != size() && equal()(m_extract(m_data[pos]), key))
+						return { begin() + pos, false };
+				}
+				data.m_position = pos;
+				return { begin() + pos, true };
+			}
+
+			template <class V>
+			emplace_return_type insert_value(V&& value) {
+				insert_commit_data data;
+				auto result = insert_check(m_extract(value), data);
+				if (result.second)
+					result.first = insert_commit(data, std::forward<V>(value));
+				if constexpr (AllowDuplicates)
+					return result.first;
+				else
+					return result;
+			}
+
+			// Sorts the elements appended past the first n and merges them into the sorted prefix
+			void merge_back(size_type n) {
+				this->observer().on_move(merge_appended<AllowDuplicates, false>(m_data, n, val_cmp()));
+			}
+
+			// Merges the sorted elements appended past the first n into the sorted prefix
+			void merge_sorted_back(size_type n) {
+				this->observer().on_move(merge_appended<AllowDuplicates, true>(m_data, n, val_cmp()));
+			}
+
 		public:
 
 			// ctor
@@ -201,7 +334,8 @@ namespace libra {
 				, m_val_cmp(comp)
 				, m_equal(comp)
 				, m_extract()
-				, m_data(alloc) {}
+				, m_data(alloc)
+				, m_index(alloc) {}
 
 			explicit ordered_container(const Allocator& alloc)
 				: ordered_container(Compare(), alloc) {}
@@ -220,13 +354,32 @@ namespace libra {
 				const Allocator& alloc)
 				: ordered_container(first, last, Compare(), alloc) {}
 
+			template <class InIt>
+			ordered_container(sorted_tag_type tag, InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: ordered_container(comp, alloc)
+			{
+				insert(tag, first, last);
+			}
+
+			template <class InIt>
+			ordered_container(sorted_tag_type tag, InIt first, InIt last,
+				const Allocator& alloc)
+				: ordered_container(tag, first, last, Compare(), alloc) {}
+
 			ordered_container(const ordered_container&) = default;
 			ordered_container(const ordered_container& other, const Allocator& alloc)
 				: m_key_cmp(other.m_key_cmp)
 				, m_val_cmp(other.m_val_cmp)
 				, m_equal(other.m_equal)
 				, m_extract(other.m_extract)
-				, m_data(other.m_data, alloc) {}
+				, m_data(other.m_data, alloc)
+				, m_index(alloc)
+			{
+				if (other.frozen())
+					m_index.build(m_data.data(), m_data.size(), m_extract);
+			}
 
 			ordered_container(ordered_container&&) = default;
 			ordered_container(ordered_container&& other, const Allocator& alloc)
@@ -234,7 +387,13 @@ namespace libra {
 				, m_val_cmp(std::move(other.m_val_cmp))
 				, m_equal(std::move(other.m_equal))
 				, m_extract(std::move(other.m_extract))
-				, m_data(std::move(other.m_data), alloc) {}
+				, m_data(std::move(other.m_data), alloc)
+				, m_index(alloc)
+			{
+				if (other.frozen())
+					m_index.build(m_data.data(), m_data.size(), m_extract);
+				other.sync_index();
+			}
 
 			ordered_container(std::initializer_list<value_type> list,
 				const Compare& comp = Compare(),
@@ -245,6 +404,15 @@ namespace libra {
 				const Allocator& alloc)
 				: ordered_container(list, Compare(), alloc) {}
 
+			ordered_container(sorted_tag_type tag, std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: ordered_container(tag, list.begin(), list.end(), comp, alloc) {}
+
+			ordered_container(sorted_tag_type tag, std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: ordered_container(tag, list, Compare(), alloc) {}
+
 			// dtor
 			~ordered_container() = default;
 
@@ -284,49 +452,149 @@ namespace libra {
 			size_type size() const noexcept { return m_data.size(); }
 			size_type max_size() const noexcept { return m_data.max_size(); }
 			size_type capacity() const noexcept { return m_data.capacity(); }
-			void reserve(size_type new_cap) { m_data.reserve(new_cap); }
-			void shrink_to_fit() { m_data.shrink_to_fit(); }
+			void reserve(size_type new_cap) {
+				size_type cap = m_data.capacity();
+				m_data.reserve(new_cap);
+				note_capacity(cap, size());
+			}
+
+			void shrink_to_fit() {
+				size_type cap = m_data.capacity();
+				m_data.shrink_to_fit();
+				note_capacity(cap, size());
+			}
+
+			// memory, see libra::memory_footprint
+			size_type allocated_bytes() const noexcept {
+				return vector_bytes(m_data) + m_index.allocated_bytes();
+			}
+
+			size_type wasted_capacity() const noexcept {
+				return allocated_bytes() - size() * sizeof(value_type);
+			}
+
+			memory_footprint memory_usage() const {
+				return make_footprint(allocated_bytes(), size() * sizeof(value_type), m_data.begin(), m_data.end());
+			}
 
 			// modifiers
-			void clear() noexcept { m_data.clear(); }
+			void clear() noexcept {
+				m_data.clear();
+				sync_index();
+			}
 
-			emplace_return_type insert(const value_type& value) { return emplace(value); }
-			emplace_return_type insert(value_type&& value) { return emplace(std::move(value)); }
+			emplace_return_type insert(const value_type& value) { return insert_value(value); }
+			emplace_return_type insert(value_type&& value) { return insert_value(std::move(value)); }
 
 			iterator insert(const_iterator hint, const value_type& value) { return emplace_hint(hint, value); }
 			iterator insert(const_iterator hint, value_type&& value) { return emplace_hint(hint, std::move(value)); }
 
 			template <class InIt>
 			void insert(InIt first, InIt last) {
-				for (auto it = first; it != last; ++it)
-					insert(cend(), *it);
+				size_type n = size();
+				size_type cap = m_data.capacity();
+				m_data.insert(m_data.end(), first, last);
+				note_capacity(cap, n);
+				merge_back(n);
+				sync_index();
 			}
 
 			void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
 
+			template <class InIt>
+			void insert(sorted_tag_type, InIt first, InIt last) {
+				size_type n = size();
+				size_type cap = m_data.capacity();
+				m_data.insert(m_data.end(), first, last);
+				note_capacity(cap, n);
+				assert(range_in_order(begin() + n, end()) && "Range is not sorted!");
+				merge_sorted_back(n);
+				sync_index();
+			}
+
+			void insert(sorted_tag_type tag, std::initializer_list<value_type> list) {
+				insert(tag, list.begin(), list.end());
+			}
+
 			template <class... Args>
 			emplace_return_type emplace(Args&&... args) {
-				if constexpr (AllowDuplicates) {
-					return emplace_common(std::forward<Args>(args)...);
-				}
-				else {
-					return emplace_unique(std::forward<Args>(args)...);
-				}
+				auto result = [&]() {
+					if constexpr (AllowDuplicates) {
+						return emplace_common(std::forward<Args>(args)...);
+					}
+					else {
+						return emplace_unique(std::forward<Args>(args)...);
+					}
+				}();
+				sync_index();
+				return result;
 			}
 
 			template <class... Args>
 			iterator emplace_hint(const_iterator hint, Args&&... args) {
-				if constexpr (AllowDuplicates) {
-					return emplace_hint_common(hint, std::forward<Args>(args)...);
-				}
-				else {
-					return emplace_hint_unique(hint, std::forward<Args>(args)...);
-				}
+				auto result = [&]() {
+					if constexpr (AllowDuplicates) {
+						return emplace_hint_common(hint, std::forward<Args>(args)...);
+					}
+					else {
+						return emplace_hint_unique(hint, std::forward<Args>(args)...);
+					}
+				}();
+				sync_index();
+				return result;
+			}
+
+			// Finds where an element with the given key belongs without constructing one.
+			// Unique containers return the equivalent element and false if there is one.
+			// Otherwise data is filled in for insert_commit and the result is true.
+			std::pair<iterator, bool> insert_check(const key_type& key, insert_commit_data& data) {
+				return check_position(AllowDuplicates ? upper_index(key) : lower_index(key), key, data);
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, std::pair<iterator, bool>>
+				insert_check(const Key& key, insert_commit_data& data) {
+				return check_position(AllowDuplicates ? upper_index(key) : lower_index(key), key, data);
+			}
+
+			std::pair<iterator, bool> insert_check(const_iterator hint, const key_type& key, insert_commit_data& data) {
+				return check_position(bound_index<AllowDuplicates>(hint, key), key, data);
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, std::pair<iterator, bool>>
+				insert_check(const_iterator hint, const Key& key, insert_commit_data& data) {
+				return check_position(bound_index<AllowDuplicates>(hint, key), key, data);
+			}
+
+			// Constructs the element checked by insert_check in place, without searching again.
+			// The element's key must be the one passed to insert_check.
+			template <class... Args>
+			iterator insert_commit(const insert_commit_data& data, Args&&... args) {
+				assert(data.m_position <= size() && "Stale insert position!");
+				size_type cap = m_data.capacity();
+				auto it = m_data.emplace(cbegin() + data.m_position, std::forward<Args>(args)...);
+				note_capacity(cap, size() - 1);
+				if (m_data.capacity() == cap)
+					this->observer().on_move(end() - it - 1);
+				assert(range_in_order(it == cbegin() ? it : it - 1, it == cend() - 1 ? cend() : it + 2)
+					&& "Committed element is out of order!");
+				sync_index();
+				return it;
+			}
+
+			iterator erase(const_iterator pos) {
+				this->observer().on_move(cend() - pos - 1);
+				auto it = m_data.erase(pos);
+				sync_index();
+				return it;
 			}
 
-			iterator erase(const_iterator pos) { return m_data.erase(pos); }
 			iterator erase(const_iterator first, const_iterator last) { 
-				return m_data.erase(first, last);
+				this->observer().on_move(cend() - last);
+				auto it = m_data.erase(first, last);
+				sync_index();
+				return it;
 			}
 
 			size_type erase(const key_type& key) {
@@ -337,6 +605,30 @@ namespace libra {
 				return count;
 			}
 
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare> && !std::is_convertible_v<const Key&, const_iterator>, size_type>
+				erase(const Key& key) {
+				auto range = equal_range(key);
+				auto count = range.second - range.first;
+				if (count > 0)
+					erase(range.first, range.second);
+				return count;
+			}
+
+			// Moves the sorted storage out of the container, leaving it empty
+			container_type extract() && {
+				container_type data = std::move(m_data);
+				clear();
+				return data;
+			}
+
+			// Adopts storage that is already sorted according to the container's ordering
+			void replace(container_type&& data) {
+				assert(range_in_order(data.begin(), data.end()) && "Storage is not sorted!");
+				m_data = std::move(data);
+				sync_index();
+			}
+
 			void swap(ordered_container& other)
 				noexcept(std::allocator_traits<Allocator>::is_always_equal::value
 					&& std::is_nothrow_swappable<Compare>::value)
@@ -347,6 +639,7 @@ namespace libra {
 					std::swap(m_equal, other.m_equal);
 					std::swap(m_extract, other.m_extract);
 					std::swap(m_data, other.m_data);
+					std::swap(m_index, other.m_index);
 				}
 			}
 
@@ -365,26 +658,26 @@ namespace libra {
 
 			iterator find(const key_type& key) {
 				auto lower = lower_bound(key);
-				return lower != end() && m_equal(m_extract(*lower), key) ? lower : end();
+				return lower != end() && equal()(m_extract(*lower), key) ? lower : end();
 			}
 
 			const_iterator find(const key_type& key) const {
 				auto lower = lower_bound(key);
-				return lower != end() && m_equal(m_extract(*lower), key) ? lower : end();
+				return lower != end() && equal()(m_extract(*lower), key) ? lower : end();
 			}
 
 			template <class Key>
 			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
 				find(const Key& key) {
 				auto lower = lower_bound(key);
-				return lower != end() && m_equal(m_extract(*lower), key) ? lower : end();
+				return lower != end() && equal()(m_extract(*lower), key) ? lower : end();
 			}
 
 			template <class Key>
 			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
 				find(const Key& key) const {
 				auto lower = lower_bound(key);
-				return lower != end() && m_equal(m_extract(*lower), key) ? lower : end();
+				return lower != end() && equal()(m_extract(*lower), key) ? lower : end();
 			}
 
 			bool contains(const key_type& key) const {
@@ -397,76 +690,223 @@ namespace libra {
 				return find(key) != end();
 			}
 
+			// The upper bound is galloped to from the lower bound rather than searched for again
 			std::pair<iterator, iterator> equal_range(const key_type& key) {
-				return { lower_bound(key), upper_bound(key) };
+				auto lower = lower_bound(key);
+				return { lower, upper_bound(lower, key) };
 			}
 
 			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
-				return { lower_bound(key), upper_bound(key) };
+				auto lower = lower_bound(key);
+				return { lower, upper_bound(lower, key) };
 			}
 
 			template <class Key>
 			std::enable_if_t<is_transparent_v<Key, Compare>, std::pair<iterator, iterator>>
 				equal_range(const Key& key) {
-				return { lower_bound(key), upper_bound(key) };
+				auto lower = lower_bound(key);
+				return { lower, upper_bound(lower, key) };
 			}
 			
 			template <class Key>
 			std::enable_if_t<is_transparent_v<Key, Compare>, std::pair<const_iterator, const_iterator>>
 				equal_range(const Key& key) const {
-				return { lower_bound(key), upper_bound(key) };
+				auto lower = lower_bound(key);
+				return { lower, upper_bound(lower, key) };
 			}
 
 			iterator lower_bound(const key_type& key) {
-				return detail::lower_bound(begin(), end(), key, m_key_cmp, m_extract); 
+				return begin() + lower_index(key);
 			}
 
 			const_iterator lower_bound(const key_type& key) const {
-				return detail::lower_bound(begin(), end(), key, m_key_cmp, m_extract);
+				return begin() + lower_index(key);
 			}
 
 			template <class Key>
 			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
 				lower_bound(const Key& key) {
-				return detail::lower_bound(begin(), end(), key, m_key_cmp, m_extract);
+				return begin() + lower_index(key);
 			}
 
 			template <class Key>
 			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
 				lower_bound(const Key& key) const {
-				return detail::lower_bound(begin(), end(), key, m_key_cmp, m_extract);
+				return begin() + lower_index(key);
 			}
 
 			iterator upper_bound(const key_type& key) {
-				return detail::upper_bound(begin(), end(), key, m_key_cmp, m_extract); 
+				return begin() + upper_index(key);
 			}
 
 			const_iterator upper_bound(const key_type& key) const {
-				return detail::upper_bound(begin(), end(), key, m_key_cmp, m_extract);
+				return begin() + upper_index(key);
 			}
 
 			template <class Key>
 			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
 				upper_bound(const Key& key) {
-				return detail::upper_bound(begin(), end(), key, m_key_cmp, m_extract);
+				return begin() + upper_index(key);
 			}
 
 			template <class Key>
 			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
 				upper_bound(const Key& key) const {
-				return detail::upper_bound(begin(), end(), key, m_key_cmp, m_extract);
+				return begin() + upper_index(key);
+			}
+
+			// hinted lookup, searching outward from hint in O(log d) probes where d is
+			// the distance from hint to the result
+			iterator find(const_iterator hint, const key_type& key) {
+				auto lower = lower_bound(hint, key);
+				return lower != end() && equal()(m_extract(*lower), key) ? lower : end();
+			}
+
+			const_iterator find(const_iterator hint, const key_type& key) const {
+				auto lower = lower_bound(hint, key);
+				return lower != end() && equal()(m_extract(*lower), key) ? lower : end();
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
+				find(const_iterator hint, const Key& key) {
+				auto lower = lower_bound(hint, key);
+				return lower != end() && equal()(m_extract(*lower), key) ? lower : end();
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
+				find(const_iterator hint, const Key& key) const {
+				auto lower = lower_bound(hint, key);
+				return lower != end() && equal()(m_extract(*lower), key) ? lower : end();
+			}
+
+			std::pair<iterator, iterator> equal_range(const_iterator hint, const key_type& key) {
+				auto lower = lower_bound(hint, key);
+				return { lower, upper_bound(lower, key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const_iterator hint, const key_type& key) const {
+				auto lower = lower_bound(hint, key);
+				return { lower, upper_bound(lower, key) };
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, std::pair<iterator, iterator>>
+				equal_range(const_iterator hint, const Key& key) {
+				auto lower = lower_bound(hint, key);
+				return { lower, upper_bound(lower, key) };
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, std::pair<const_iterator, const_iterator>>
+				equal_range(const_iterator hint, const Key& key) const {
+				auto lower = lower_bound(hint, key);
+				return { lower, upper_bound(lower, key) };
+			}
+
+			iterator lower_bound(const_iterator hint, const key_type& key) {
+				return begin() + bound_index<false>(hint, key);
+			}
+
+			const_iterator lower_bound(const_iterator hint, const key_type& key) const {
+				return begin() + bound_index<false>(hint, key);
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
+				lower_bound(const_iterator hint, const Key& key) {
+				return begin() + bound_index<false>(hint, key);
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
+				lower_bound(const_iterator hint, const Key& key) const {
+				return begin() + bound_index<false>(hint, key);
+			}
+
+			iterator upper_bound(const_iterator hint, const key_type& key) {
+				return begin() + bound_index<true>(hint, key);
+			}
+
+			const_iterator upper_bound(const_iterator hint, const key_type& key) const {
+				return begin() + bound_index<true>(hint, key);
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, iterator>
+				upper_bound(const_iterator hint, const Key& key) {
+				return begin() + bound_index<true>(hint, key);
+			}
+
+			template <class Key>
+			std::enable_if_t<is_transparent_v<Key, Compare>, const_iterator>
+				upper_bound(const_iterator hint, const Key& key) const {
+				return begin() + bound_index<true>(hint, key);
+			}
+
+			// Builds a static B+ tree index over the elements that lookups use until thaw().
+			// Modifications of a frozen container rebuild the index.
+			void freeze() {
+				static_assert(static_index<key_type, Compare, Allocator>::supported,
+					"Frozen containers require default constructible, copy assignable keys!");
+				m_index.build(m_data.data(), m_data.size(), m_extract);
+			}
+
+			void thaw() noexcept {
+				m_index.reset();
+			}
+
+			bool frozen() const noexcept {
+				return m_index.enabled();
+			}
+
+			// batched lookup, see libra::lower_bound_many
+			template <class FwdIt, class OutIt>
+			OutIt find_many(FwdIt first, FwdIt last, OutIt out) {
+				return detail::bound_many<false>(begin(), end(), first, last, out, key_cmp(), m_extract,
+					[this](iterator it, const auto& key) { return it != end() && equal()(m_extract(*it), key) ? it : end(); });
+			}
+
+			template <class FwdIt, class OutIt>
+			OutIt find_many(FwdIt first, FwdIt last, OutIt out) const {
+				return detail::bound_many<false>(begin(), end(), first, last, out, key_cmp(), m_extract,
+					[this](const_iterator it, const auto& key) { return it != end() && equal()(m_extract(*it), key) ? it : end(); });
+			}
+
+			template <class FwdIt, class OutIt>
+			OutIt lower_bound_many(FwdIt first, FwdIt last, OutIt out) {
+				return detail::bound_many<false>(begin(), end(), first, last, out, key_cmp(), m_extract, detail::keep_bound{});
+			}
+
+			template <class FwdIt, class OutIt>
+			OutIt lower_bound_many(FwdIt first, FwdIt last, OutIt out) const {
+				return detail::bound_many<false>(begin(), end(), first, last, out, key_cmp(), m_extract, detail::keep_bound{});
+			}
+
+			template <class FwdIt, class OutIt>
+			OutIt upper_bound_many(FwdIt first, FwdIt last, OutIt out) {
+				return detail::bound_many<true>(begin(), end(), first, last, out, key_cmp(), m_extract, detail::keep_bound{});
+			}
+
+			template <class FwdIt, class OutIt>
+			OutIt upper_bound_many(FwdIt first, FwdIt last, OutIt out) const {
+				return detail::bound_many<true>(begin(), end(), first, last, out, key_cmp(), m_extract, detail::keep_bound{});
 			}
 
 			// observers
 			key_compare key_comp() const { return m_key_cmp; }
 			value_compare value_comp() const { return m_val_cmp; }
 
+			// instrumentation, see libra::counting_stats
+			using stats_holder<Stats>::stats;
+
 		};
 
-		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates>
+		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates, class SearchPolicy, class Stats>
 		bool operator==(
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& lhs,
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& rhs)
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& lhs,
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& rhs)
 		{
 			auto comp = lhs.value_comp();
 			auto equal = [&comp](const auto& lhs, const auto& rhs) {
@@ -475,43 +915,43 @@ namespace libra {
 			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), equal);
 		}
 
-		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates>
+		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates, class SearchPolicy, class Stats>
 		bool operator!=(
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& lhs,
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& rhs)
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& lhs,
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& rhs)
 		{
 			return !(lhs == rhs);
 		}
 
-		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates>
+		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates, class SearchPolicy, class Stats>
 		bool operator<(
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& lhs,
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& rhs)
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& lhs,
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& rhs)
 		{
 			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lhs.value_comp());
 		}
 
-		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates>
+		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates, class SearchPolicy, class Stats>
 		bool operator<=(
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& lhs,
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& rhs)
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& lhs,
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& rhs)
 		{
 			return !(rhs < lhs);
 		}
 		
 		
-		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates>
+		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates, class SearchPolicy, class Stats>
 		bool operator>(
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& lhs,
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& rhs)
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& lhs,
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& rhs)
 		{
 			return rhs < lhs;
 		}
 
-		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates>
+		template <class Value, class Compare, class Allocator, class ExtractKey, bool AllowDuplicates, class SearchPolicy, class Stats>
 		bool operator>=(
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& lhs,
-			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates>& rhs)
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& lhs,
+			const ordered_container<Value, Compare, Allocator, ExtractKey, AllowDuplicates, SearchPolicy, Stats>& rhs)
 		{
 			return !(lhs < rhs);
 		}
@@ -0,0 +1,885 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cassert>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include "intrinsics.hpp"
+#include "sorted_tags.hpp"
+#include "is_transparent.hpp"
+#include "merge_appended.hpp"
+#include "ordered_container.hpp"
+#include "../algorithm/binary_search.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Bidirectional iterator over a packed memory array. A position is a segment and an
+		// offset into the elements packed at the front of that segment.
+		template <
+			class Container,
+			bool IsConst = false
+		> class pma_iterator {
+		public:
+			using iterator_category = std::bidirectional_iterator_tag;
+			using value_type        = typename Container::value_type;
+			using difference_type   = typename Container::difference_type;
+			using size_type         = typename Container::size_type;
+			using reference = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_reference,
+					typename Container::reference
+				>;
+			using pointer = std::conditional_t
+				<
+					IsConst,
+					typename Container::const_pointer,
+					typename Container::pointer
+				>;
+
+			friend class pma_iterator<Container, !IsConst>;
+			friend Container;
+
+		private:
+
+			using container_pointer = std::conditional_t<IsConst, const Container*, Container*>;
+
+			container_pointer m_cont = nullptr;
+			size_type m_segment = 0;
+			size_type m_offset = 0;
+
+			// Moves past the end of exhausted segments
+			void skip() {
+				while (m_segment != m_cont->segment_count() && m_offset == m_cont->m_counts[m_segment]) {
+					++m_segment;
+					m_offset = 0;
+				}
+			}
+
+		public:
+
+			pma_iterator() = default;
+
+			pma_iterator(container_pointer cont, size_type segment, size_type offset)
+				: m_cont(cont), m_segment(segment), m_offset(offset)
+			{
+				skip();
+			}
+
+			// non const to const iterator
+			template <bool is_const = IsConst, class = std::enable_if_t<is_const>>
+			pma_iterator(const pma_iterator<Container, false>& it)
+				: m_cont(it.m_cont)
+				, m_segment(it.m_segment)
+				, m_offset(it.m_offset) {}
+
+			// pointer-like operators
+
+			reference operator*() const {
+				return *(operator->());
+			}
+
+			pointer operator->() const {
+				assert(m_segment != m_cont->segment_count() && "Iterator not dereferenceable!");
+				return m_cont->m_slots + m_segment * m_cont->m_segment_size + m_offset;
+			}
+
+			// increment
+
+			pma_iterator& operator++() {
+				assert(m_segment != m_cont->segment_count() && "Increment out of bounds!");
+				++m_offset;
+				skip();
+				return *this;
+			}
+
+			pma_iterator operator++(int) {
+				pma_iterator tmp(*this);
+				++*this;
+				return tmp;
+			}
+
+			// decrement
+
+			pma_iterator& operator--() {
+				while (m_offset == 0) {
+					assert(m_segment != 0 && "Decrement out of bounds!");
+					m_offset = m_cont->m_counts[--m_segment];
+				}
+				--m_offset;
+				return *this;
+			}
+
+			pma_iterator operator--(int) {
+				pma_iterator tmp(*this);
+				--*this;
+				return tmp;
+			}
+
+			// comparison
+
+			template <bool is_const>
+			bool operator==(const pma_iterator<Container, is_const>& it) const noexcept {
+				return m_segment == it.m_segment && m_offset == it.m_offset;
+			}
+
+			template <bool is_const>
+			bool operator!=(const pma_iterator<Container, is_const>& it) const noexcept {
+				return !(*this == it);
+			}
+
+		};
+
+		// Sorted container of unique keys kept in a packed memory array: a sorted array split
+		// into segments of about log(capacity) slots, each holding its elements packed at its
+		// front. An insert shifts at most one segment, unless the segment is full; then the
+		// smallest enclosing window of 2^h segments whose density stays under its threshold
+		// is redistributed evenly, and the capacity doubles when even the whole array is too
+		// dense. Erasures mirror this with lower thresholds. Inserts cost O(log^2 n) amortized
+		// element moves, and scans stay sequential over mostly full cache lines.
+		template <
+			class Value,
+			class Compare,
+			class Allocator,
+			class ExtractKey
+		> class pma_ordered_container {
+			static_assert(std::is_nothrow_move_constructible_v<Value>,
+				"Rebalancing relocates elements and requires a non-throwing move constructor");
+		public:
+
+			using container_type         = std::vector<Value, Allocator>;
+			using key_type               = typename ExtractKey::type;
+			using value_type             = Value;
+			using size_type              = std::size_t;
+			using difference_type        = std::ptrdiff_t;
+			using key_compare            = Compare;
+			using value_compare          = ValueCompare<Value, Compare, ExtractKey>;
+			using allocator_type         = Allocator;
+			using reference              = Value&;
+			using const_reference        = const Value&;
+			using pointer                = Value*;
+			using const_pointer          = const Value*;
+			using iterator               = pma_iterator<pma_ordered_container>;
+			using const_iterator         = pma_iterator<pma_ordered_container, true>;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			friend iterator;
+			friend const_iterator;
+
+			static constexpr size_type min_segment_size = 8;
+
+		private:
+
+			using alloc_traits = std::allocator_traits<Allocator>;
+			using count_allocator = typename alloc_traits::template rebind_alloc<size_type>;
+
+			// Density bounds of a window, interpolated from the leaves (h = 0) to the root
+			static constexpr double leaf_upper = 1.0;
+			static constexpr double root_upper = 0.75;
+			static constexpr double leaf_lower = 0.125;
+			static constexpr double root_lower = 0.25;
+
+			key_compare m_key_cmp;
+			value_compare m_val_cmp;
+			ExtractKey m_extract;
+			Allocator m_alloc;
+			pointer m_slots = nullptr;
+			size_type m_capacity = 0;
+			size_type m_segment_size = min_segment_size;
+			size_type m_size = 0;
+			std::vector<size_type, count_allocator> m_counts;
+
+			template <class K1, class K2>
+			bool equivalent(const K1& lhs, const K2& rhs) const {
+				return !m_key_cmp(lhs, rhs) && !m_key_cmp(rhs, lhs);
+			}
+
+			size_type segment_count() const noexcept {
+				return m_counts.size();
+			}
+
+			size_type height() const noexcept {
+				return static_cast<size_type>(detail::countr_zero(static_cast<unsigned long long>(segment_count())));
+			}
+
+			pointer segment(size_type seg) const noexcept {
+				return m_slots + seg * m_segment_size;
+			}
+
+			double threshold(double leaf, double root, size_type h) const noexcept {
+				size_type top = height();
+				return top == 0 ? root : leaf + (root - leaf) * static_cast<double>(h) / static_cast<double>(top);
+			}
+
+			static size_type segment_size_for(size_type capacity) noexcept {
+				size_type bits = 64 - detail::countl_zero(static_cast<unsigned long long>(capacity));
+				size_type size = min_segment_size;
+				while (size < bits)
+					size *= 2;
+				return size;
+			}
+
+			void destroy_all() noexcept {
+				for (size_type seg = 0; seg != segment_count(); ++seg)
+					for (size_type i = 0; i != m_counts[seg]; ++i)
+						alloc_traits::destroy(m_alloc, segment(seg) + i);
+			}
+
+			void deallocate() noexcept {
+				if (m_slots)
+					alloc_traits::deallocate(m_alloc, m_slots, m_capacity);
+				m_slots = nullptr;
+				m_capacity = 0;
+				m_counts.clear();
+			}
+
+			// Moves the elements of segments [first, last) into out, leaving them empty
+			void gather(size_type first, size_type last, container_type& out) {
+				for (size_type seg = first; seg != last; ++seg) {
+					for (size_type i = 0; i != m_counts[seg]; ++i) {
+						out.emplace_back(std::move(segment(seg)[i]));
+						alloc_traits::destroy(m_alloc, segment(seg) + i);
+					}
+					m_counts[seg] = 0;
+				}
+			}
+
+			// Spreads the elements of values evenly over segments [first, first + count)
+			void spread(container_type& values, size_type first, size_type count) {
+				size_type base = values.size() / count;
+				size_type extra = values.size() % count;
+				auto it = values.begin();
+				for (size_type seg = first; seg != first + count; ++seg) {
+					size_type n = base + (seg - first < extra);
+					for (size_type i = 0; i != n; ++i, ++it)
+						alloc_traits::construct(m_alloc, segment(seg) + i, std::move(*it));
+					m_counts[seg] = n;
+				}
+			}
+
+			// Position of the element of rank r among n elements spread over the segments from first
+			iterator locate(size_type first, size_type count, size_type n, size_type r) {
+				size_type base = n / count;
+				size_type extra = n % count;
+				if (r < extra * (base + 1))
+					return iterator(this, first + r / (base + 1), r % (base + 1));
+				r -= extra * (base + 1);
+				if (base == 0)
+					return iterator(this, first + count, 0);
+				return iterator(this, first + extra + r / base, r % base);
+			}
+
+			// Replaces the storage with a fresh array of the given capacity holding values
+			void rebuild(container_type& values, size_type capacity) {
+				destroy_all();
+				deallocate();
+				m_segment_size = segment_size_for(capacity);
+				m_counts.assign(capacity / m_segment_size, 0);
+				m_slots = alloc_traits::allocate(m_alloc, capacity);
+				m_capacity = capacity;
+				spread(values, 0, segment_count());
+			}
+
+			// Smallest capacity keeping n elements at most half dense
+			static size_type capacity_for(size_type n) noexcept {
+				size_type capacity = min_segment_size;
+				while (capacity < 2 * n)
+					capacity *= 2;
+				return capacity;
+			}
+
+			// Number of leading segments whose first element satisfies pred. Every segment
+			// holds an element once there are several, so counts are only read for one.
+			template <class Pred>
+			size_type segment_partition(Pred pred) const {
+				if (segment_count() <= 1)
+					return segment_count() == 1 && m_counts[0] != 0 && pred(m_extract(*segment(0)));
+				const_pointer first = m_slots;
+				size_type len = segment_count();
+				while (len > 1) {
+					size_type half = len / 2;
+					detail::prefetch(first + (half / 2) * m_segment_size);
+					detail::prefetch(first + (half + half / 2) * m_segment_size);
+					first = pred(m_extract(first[half * m_segment_size])) ? first + half * m_segment_size : first;
+					len -= half;
+				}
+				return (first - m_slots) / m_segment_size + pred(m_extract(*first));
+			}
+
+			// Position of the lower bound of key, or of its upper bound when Upper, as a
+			// segment and an offset that may equal the segment's count
+			template <bool Upper, class Key>
+			std::pair<size_type, size_type> bound_position(const Key& key) const {
+				size_type seg = segment_partition([&](const auto& first) {
+					if constexpr (Upper)
+						return !m_key_cmp(key, first);
+					else
+						return m_key_cmp(first, key);
+				});
+				if (seg == 0)
+					return { 0, 0 };
+				--seg;
+				const_pointer first = segment(seg);
+				const_pointer last = first + m_counts[seg];
+				if constexpr (Upper)
+					return { seg, detail::upper_bound(first, last, key, m_key_cmp, m_extract) - first };
+				else
+					return { seg, detail::lower_bound(first, last, key, m_key_cmp, m_extract) - first };
+			}
+
+			// Position of the element with the given key, or of the end if there is none
+			template <class Key>
+			std::pair<size_type, size_type> find_position(const Key& key) const {
+				auto [seg, offset] = bound_position<false>(key);
+				if (seg != segment_count() && offset == m_counts[seg]) {
+					++seg;
+					offset = 0;
+				}
+				if (seg != segment_count() && offset != m_counts[seg] && equivalent(m_extract(segment(seg)[offset]), key))
+					return { seg, offset };
+				return { segment_count(), 0 };
+			}
+
+			// Inserts value at the given offset of a segment, rebalancing as needed
+			iterator insert_at(size_type seg, size_type offset, value_type&& value) {
+				for (size_type h = 0; h <= height(); ++h) {
+					size_type first = seg >> h << h;
+					size_type count = size_type(1) << h;
+					size_type n = 1;
+					for (size_type s = first; s != first + count; ++s)
+						n += m_counts[s];
+					if (static_cast<double>(n) > threshold(leaf_upper, root_upper, h) * static_cast<double>(count * m_segment_size))
+						continue;
+					if (h == 0) {
+						// shift the tail of the segment one slot right
+						pointer p = segment(seg);
+						for (size_type i = m_counts[seg]; i != offset; --i) {
+							alloc_traits::construct(m_alloc, p + i, std::move(p[i - 1]));
+							alloc_traits::destroy(m_alloc, p + i - 1);
+						}
+						alloc_traits::construct(m_alloc, p + offset, std::move(value));
+						++m_counts[seg];
+						++m_size;
+						return iterator(this, seg, offset);
+					}
+					size_type rank = offset;
+					for (size_type s = first; s != seg; ++s)
+						rank += m_counts[s];
+					container_type values(m_alloc);
+					values.reserve(n);
+					gather(first, first + count, values);
+					values.insert(values.begin() + rank, std::move(value));
+					spread(values, first, count);
+					++m_size;
+					return locate(first, count, n, rank);
+				}
+				// even the root is too dense: double the capacity
+				size_type rank = offset;
+				for (size_type s = 0; s != seg; ++s)
+					rank += m_counts[s];
+				container_type values(m_alloc);
+				values.reserve(m_size + 1);
+				gather(0, segment_count(), values);
+				values.insert(values.begin() + rank, std::move(value));
+				rebuild(values, std::max(min_segment_size, 2 * m_capacity));
+				++m_size;
+				return locate(0, segment_count(), m_size, rank);
+			}
+
+			// Restores the lower density bounds around a segment that lost an element and
+			// returns the new position of the element that followed it
+			iterator rebalance_after_erase(size_type seg, size_type offset) {
+				if (segment_count() == 1)
+					return iterator(this, seg, offset);
+				for (size_type h = 0; h <= height(); ++h) {
+					size_type first = seg >> h << h;
+					size_type count = size_type(1) << h;
+					size_type n = 0;
+					for (size_type s = first; s != first + count; ++s)
+						n += m_counts[s];
+					if (static_cast<double>(n) < threshold(leaf_lower, root_lower, h) * static_cast<double>(count * m_segment_size))
+						continue;
+					if (h == 0)
+						return iterator(this, seg, offset);
+					size_type rank = offset;
+					for (size_type s = first; s != seg; ++s)
+						rank += m_counts[s];
+					container_type values(m_alloc);
+					values.reserve(n);
+					gather(first, first + count, values);
+					spread(values, first, count);
+					return locate(first, count, n, rank);
+				}
+				// even the root is too sparse: halve the capacity
+				size_type rank = offset;
+				for (size_type s = 0; s != seg; ++s)
+					rank += m_counts[s];
+				container_type values(m_alloc);
+				values.reserve(m_size);
+				gather(0, segment_count(), values);
+				rebuild(values, m_capacity / 2);
+				return locate(0, segment_count(), m_size, rank);
+			}
+
+			template <bool Sorted, class InIt>
+			void insert_range(InIt first, InIt last) {
+				container_type values(m_alloc);
+				values.reserve(m_size);
+				gather(0, segment_count(), values);
+				auto n = values.size();
+				values.insert(values.end(), first, last);
+				assert((!Sorted || std::is_sorted(values.begin() + n, values.end(), m_val_cmp)) && "Range is not sorted!");
+				merge_appended<false, Sorted>(values, n, m_val_cmp);
+				assign(values);
+			}
+
+			void assign(container_type& values) {
+				m_size = values.size();
+				rebuild(values, capacity_for(values.size()));
+			}
+
+		public:
+
+			// ctor
+			pma_ordered_container()
+				: pma_ordered_container(Compare(), Allocator()) {}
+
+			explicit pma_ordered_container(const Compare& comp, const Allocator& alloc = Allocator())
+				: m_key_cmp(comp)
+				, m_val_cmp(comp)
+				, m_extract()
+				, m_alloc(alloc)
+				, m_counts(count_allocator(alloc)) {}
+
+			explicit pma_ordered_container(const Allocator& alloc)
+				: pma_ordered_container(Compare(), alloc) {}
+
+			template <class InIt>
+			pma_ordered_container(InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: pma_ordered_container(comp, alloc)
+			{
+				insert(first, last);
+			}
+
+			template <class InIt>
+			pma_ordered_container(InIt first, InIt last,
+				const Allocator& alloc)
+				: pma_ordered_container(first, last, Compare(), alloc) {}
+
+			template <class InIt>
+			pma_ordered_container(sorted_unique_t tag, InIt first, InIt last,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: pma_ordered_container(comp, alloc)
+			{
+				insert(tag, first, last);
+			}
+
+			template <class InIt>
+			pma_ordered_container(sorted_unique_t tag, InIt first, InIt last,
+				const Allocator& alloc)
+				: pma_ordered_container(tag, first, last, Compare(), alloc) {}
+
+			pma_ordered_container(const pma_ordered_container& other)
+				: m_key_cmp(other.m_key_cmp)
+				, m_val_cmp(other.m_val_cmp)
+				, m_extract(other.m_extract)
+				, m_alloc(alloc_traits::select_on_container_copy_construction(other.m_alloc))
+				, m_counts(count_allocator(m_alloc))
+			{
+				container_type values(m_alloc);
+				values.reserve(other.size());
+				values.insert(values.end(), other.begin(), other.end());
+				assign(values);
+			}
+
+			pma_ordered_container(pma_ordered_container&& other) noexcept
+				: m_key_cmp(std::move(other.m_key_cmp))
+				, m_val_cmp(std::move(other.m_val_cmp))
+				, m_extract(std::move(other.m_extract))
+				, m_alloc(std::move(other.m_alloc))
+				, m_slots(std::exchange(other.m_slots, nullptr))
+				, m_capacity(std::exchange(other.m_capacity, 0))
+				, m_segment_size(std::exchange(other.m_segment_size, min_segment_size))
+				, m_size(std::exchange(other.m_size, 0))
+				, m_counts(std::move(other.m_counts))
+			{
+				other.m_counts.clear();
+			}
+
+			pma_ordered_container(std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: pma_ordered_container(list.begin(), list.end(), comp, alloc) {}
+
+			pma_ordered_container(std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: pma_ordered_container(list, Compare(), alloc) {}
+
+			pma_ordered_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Compare& comp = Compare(),
+				const Allocator& alloc = Allocator())
+				: pma_ordered_container(tag, list.begin(), list.end(), comp, alloc) {}
+
+			pma_ordered_container(sorted_unique_t tag, std::initializer_list<value_type> list,
+				const Allocator& alloc)
+				: pma_ordered_container(tag, list, Compare(), alloc) {}
+
+			// dtor
+			~pma_ordered_container() {
+				destroy_all();
+				deallocate();
+			}
+
+			// assignment
+			pma_ordered_container& operator=(const pma_ordered_container& other) {
+				if (this != &other) {
+					pma_ordered_container copy(other);
+					swap(copy);
+				}
+				return *this;
+			}
+
+			pma_ordered_container& operator=(pma_ordered_container&& other) noexcept {
+				if (this != &other) {
+					pma_ordered_container thief(std::move(other));
+					swap(thief);
+				}
+				return *this;
+			}
+
+			pma_ordered_container& operator=(std::initializer_list<value_type> list) {
+				clear();
+				insert(list);
+				return *this;
+			}
+
+			allocator_type get_allocator() const noexcept { return m_alloc; }
+
+			// iterators
+			iterator begin() noexcept { return iterator(this, 0, 0); }
+			const_iterator begin() const noexcept { return const_iterator(this, 0, 0); }
+			const_iterator cbegin() const noexcept { return begin(); }
+
+			iterator end() noexcept { return iterator(this, segment_count(), 0); }
+			const_iterator end() const noexcept { return const_iterator(this, segment_count(), 0); }
+			const_iterator cend() const noexcept { return end(); }
+
+			reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+			// capacity
+			bool empty() const noexcept { return m_size == 0; }
+			size_type size() const noexcept { return m_size; }
+			size_type max_size() const noexcept { return alloc_traits::max_size(m_alloc); }
+			size_type capacity() const noexcept { return m_capacity; }
+			size_type segment_size() const noexcept { return m_segment_size; }
+
+			// memory, see libra::memory_footprint
+			size_type allocated_bytes() const noexcept {
+				return m_capacity * sizeof(value_type) + vector_bytes(m_counts);
+			}
+
+			size_type wasted_capacity() const noexcept {
+				return allocated_bytes() - size() * sizeof(value_type);
+			}
+
+			memory_footprint memory_usage() const {
+				return make_footprint(allocated_bytes(), size() * sizeof(value_type), begin(), end());
+			}
+
+			// modifiers
+			void clear() noexcept {
+				destroy_all();
+				deallocate();
+				m_size = 0;
+			}
+
+			std::pair<iterator, bool> insert(const value_type& value) { return emplace(value); }
+			std::pair<iterator, bool> insert(value_type&& value) { return emplace(std::move(value)); }
+
+			iterator insert(const_iterator hint, const value_type& value) { return emplace_hint(hint, value); }
+			iterator insert(const_iterator hint, value_type&& value) { return emplace_hint(hint, std::move(value)); }
+
+			template <class InIt>
+			void insert(InIt first, InIt last) {
+				insert_range<false>(first, last);
+			}
+
+			void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+			template <class InIt>
+			void insert(sorted_unique_t, InIt first, InIt last) {
+				insert_range<true>(first, last);
+			}
+
+			void insert(sorted_unique_t tag, std::initializer_list<value_type> list) {
+				insert(tag, list.begin(), list.end());
+			}
+
+			template <class... Args>
+			std::pair<iterator, bool> emplace(Args&&... args) {
+				value_type value(std::forward<Args>(args)...);
+				if (m_capacity == 0) {
+					container_type values(m_alloc);
+					rebuild(values, min_segment_size);
+				}
+				auto [seg, offset] = bound_position<false>(m_extract(value));
+				// an equivalent element may also open the next segment
+				iterator lower(this, seg, offset);
+				if (lower != end() && equivalent(m_extract(*lower), m_extract(value)))
+					return { lower, false };
+				return { insert_at(seg, offset, std::move(value)), true };
+			}
+
+			// Positions are found by searching; the hint is not needed
+			template <class... Args>
+			iterator emplace_hint(const_iterator, Args&&... args) {
+				return emplace(std::forward<Args>(args)...).first;
+			}
+
+			iterator erase(const_iterator pos) {
+				assert(pos != cend() && "Iterator not dereferenceable!");
+				size_type seg = pos.m_segment;
+				size_type offset = pos.m_offset;
+				pointer p = segment(seg);
+				alloc_traits::destroy(m_alloc, p + offset);
+				for (size_type i = offset + 1; i != m_counts[seg]; ++i) {
+					alloc_traits::construct(m_alloc, p + i - 1, std::move(p[i]));
+					alloc_traits::destroy(m_alloc, p + i);
+				}
+				--m_counts[seg];
+				--m_size;
+				return rebalance_after_erase(seg, offset);
+			}
+
+			iterator erase(const_iterator first, const_iterator last) {
+				size_type count = std::distance(first, last);
+				iterator it(this, first.m_segment, first.m_offset);
+				while (count--)
+					it = erase(it);
+				return it;
+			}
+
+			size_type erase(const key_type& key) {
+				auto it = find(key);
+				if (it == end())
+					return 0;
+				erase(it);
+				return 1;
+			}
+
+			// Moves the elements out of the container into a sorted array, leaving it empty
+			container_type extract() && {
+				container_type values(m_alloc);
+				values.reserve(m_size);
+				gather(0, segment_count(), values);
+				clear();
+				return values;
+			}
+
+			// Adopts the elements of a sorted array of unique elements
+			void replace(container_type&& data) {
+				assert(std::adjacent_find(data.begin(), data.end(), [this](const value_type& lhs, const value_type& rhs) {
+					return !m_val_cmp(lhs, rhs);
+				}) == data.end() && "Storage is not sorted!");
+				clear();
+				assign(data);
+			}
+
+			void swap(pma_ordered_container& other) noexcept {
+				std::swap(m_key_cmp, other.m_key_cmp);
+				std::swap(m_val_cmp, other.m_val_cmp);
+				std::swap(m_extract, other.m_extract);
+				std::swap(m_alloc, other.m_alloc);
+				std::swap(m_slots, other.m_slots);
+				std::swap(m_capacity, other.m_capacity);
+				std::swap(m_segment_size, other.m_segment_size);
+				std::swap(m_size, other.m_size);
+				m_counts.swap(other.m_counts);
+			}
+
+			// lookup
+			size_type count(const key_type& key) const {
+				return contains(key);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, size_type>
+				count(const K& key) const {
+				return contains(key);
+			}
+
+			iterator find(const key_type& key) {
+				auto [seg, offset] = find_position(key);
+				return iterator(this, seg, offset);
+			}
+
+			const_iterator find(const key_type& key) const {
+				auto [seg, offset] = find_position(key);
+				return const_iterator(this, seg, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				find(const K& key) {
+				auto [seg, offset] = find_position(key);
+				return iterator(this, seg, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				find(const K& key) const {
+				auto [seg, offset] = find_position(key);
+				return const_iterator(this, seg, offset);
+			}
+
+			bool contains(const key_type& key) const {
+				return find(key) != end();
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, bool>
+				contains(const K& key) const {
+				return find(key) != end();
+			}
+
+			std::pair<iterator, iterator> equal_range(const key_type& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<iterator, iterator>>
+				equal_range(const K& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<const_iterator, const_iterator>>
+				equal_range(const K& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			iterator lower_bound(const key_type& key) {
+				auto [seg, offset] = bound_position<false>(key);
+				return iterator(this, seg, offset);
+			}
+
+			const_iterator lower_bound(const key_type& key) const {
+				auto [seg, offset] = bound_position<false>(key);
+				return const_iterator(this, seg, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				lower_bound(const K& key) {
+				auto [seg, offset] = bound_position<false>(key);
+				return iterator(this, seg, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				lower_bound(const K& key) const {
+				auto [seg, offset] = bound_position<false>(key);
+				return const_iterator(this, seg, offset);
+			}
+
+			iterator upper_bound(const key_type& key) {
+				auto [seg, offset] = bound_position<true>(key);
+				return iterator(this, seg, offset);
+			}
+
+			const_iterator upper_bound(const key_type& key) const {
+				auto [seg, offset] = bound_position<true>(key);
+				return const_iterator(this, seg, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				upper_bound(const K& key) {
+				auto [seg, offset] = bound_position<true>(key);
+				return iterator(this, seg, offset);
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				upper_bound(const K& key) const {
+				auto [seg, offset] = bound_position<true>(key);
+				return const_iterator(this, seg, offset);
+			}
+
+			// observers
+			key_compare key_comp() const { return m_key_cmp; }
+			value_compare value_comp() const { return m_val_cmp; }
+
+		};
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator==(
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			auto comp = lhs.value_comp();
+			auto equal = [&comp](const Value& lhs, const Value& rhs) {
+				return !comp(lhs, rhs) && !comp(rhs, lhs);
+			};
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), equal);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator!=(
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<(
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), lhs.value_comp());
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator<=(
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>(
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return rhs < lhs;
+		}
+
+		template <class Value, class Compare, class Allocator, class ExtractKey>
+		bool operator>=(
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& lhs,
+			const pma_ordered_container<Value, Compare, Allocator, ExtractKey>& rhs)
+		{
+			return !(lhs < rhs);
+		}
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cmath>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include "../algorithm/binary_search.hpp"
+
+namespace libra {
+
+	// Search policies decide how the sorted containers locate a key. A policy is a stateless
+	// type providing lower_bound and upper_bound over a sorted random access range.
+
+	// Branchless binary search, the default
+	struct binary_search_policy {
+		template <class RndIt, class Key, class Compare, class ExtractKey>
+		RndIt lower_bound(RndIt first, RndIt last, const Key& key, Compare comp, ExtractKey extract) const {
+			return detail::lower_bound(first, last, key, comp, extract);
+		}
+
+		template <class RndIt, class Key, class Compare, class ExtractKey>
+		RndIt upper_bound(RndIt first, RndIt last, const Key& key, Compare comp, ExtractKey extract) const {
+			return detail::upper_bound(first, last, key, comp, extract);
+		}
+	};
+
+	namespace detail {
+
+		// Interpolation needs arithmetic keys ordered by std::less
+		template <class RndIt, class Key, class Compare, class ExtractKey>
+		constexpr bool use_interpolation_search_v = []() {
+			using extracted_t = std::decay_t<decltype(std::declval<ExtractKey>()(*std::declval<RndIt>()))>;
+			if constexpr (std::is_arithmetic_v<Key> && std::is_same_v<Key, extracted_t>) {
+				return std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>;
+			}
+			else
+				return false;
+		}();
+
+		// Interpolation search. Each round predicts the position of key from the keys at the
+		// ends of the range, probes it, then gallops away from the prediction in steps growing
+		// fourfold until the key is bracketed, so the next round interpolates over a range
+		// proportional to the prediction error. After a fixed number of rounds, which bounds
+		// the cost on skewed distributions, the remainder is binary searched.
+		template <bool Upper, class RndIt, class Key, class Compare, class ExtractKey>
+		RndIt interpolation_bound(RndIt first, RndIt last, const Key& key, Compare comp, ExtractKey extract)
+		{
+			using diff_t = typename std::iterator_traits<RndIt>::difference_type;
+			constexpr diff_t guard = 16;
+			auto before = [&](const auto& value) {
+				if constexpr (Upper)
+					return !comp(key, extract(value));
+				else
+					return comp(extract(value), key);
+			};
+			for (int round = 0; round != 4 && last - first > guard; ++round) {
+				diff_t len = last - first;
+				if (!before(*first))
+					return first;
+				if (before(*std::prev(last)))
+					return last;
+				// Both ends bracket key, but wide integers and infinities can make the end
+				// keys equal or their span infinite as doubles, which leaves binary search
+				double lo = static_cast<double>(extract(*first));
+				double hi = static_cast<double>(extract(*std::prev(last)));
+				if (!(hi > lo))
+					break;
+				double offset = (static_cast<double>(key) - lo) / (hi - lo) * static_cast<double>(len - 1);
+				if (!std::isfinite(offset))
+					break;
+				RndIt mid = first + static_cast<diff_t>(std::clamp(offset, 1.0, static_cast<double>(len - 2)));
+				if (before(*mid)) {
+					first = std::next(mid);
+					for (diff_t step = guard; step < last - first; step *= 4) {
+						RndIt probe = first + step;
+						if (!before(*probe)) {
+							last = probe;
+							break;
+						}
+						first = std::next(probe);
+					}
+				}
+				else {
+					last = mid;
+					for (diff_t step = guard; step < last - first; step *= 4) {
+						RndIt probe = last - step;
+						if (before(*probe)) {
+							first = std::next(probe);
+							break;
+						}
+						last = probe;
+					}
+				}
+			}
+			if constexpr (Upper)
+				return detail::upper_bound(first, last, key, comp, extract);
+			else
+				return detail::lower_bound(first, last, key, comp, extract);
+		}
+
+	}
+
+	// Interpolation search for near-uniformly distributed arithmetic keys such as timestamps
+	// and sequential identifiers, finishing with a short binary search. Other keys and
+	// comparators use binary search.
+	struct interpolation_search_policy {
+		template <class RndIt, class Key, class Compare, class ExtractKey>
+		RndIt lower_bound(RndIt first, RndIt last, const Key& key, Compare comp, ExtractKey extract) const {
+			if constexpr (detail::use_interpolation_search_v<RndIt, Key, Compare, ExtractKey>)
+				return detail::interpolation_bound<false>(first, last, key, comp, extract);
+			else
+				return detail::lower_bound(first, last, key, comp, extract);
+		}
+
+		template <class RndIt, class Key, class Compare, class ExtractKey>
+		RndIt upper_bound(RndIt first, RndIt last, const Key& key, Compare comp, ExtractKey extract) const {
+			if constexpr (detail::use_interpolation_search_v<RndIt, Key, Compare, ExtractKey>)
+				return detail::interpolation_bound<true>(first, last, key, comp, extract);
+			else
+				return detail::upper_bound(first, last, key, comp, extract);
+		}
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include "iterator.hpp"
+#include "intrinsics.hpp"
+#include "extract_key.hpp"
+
+namespace libra {
+	namespace detail {
+
+		template <class T>
+		constexpr bool is_simd_key_v =
+			(std::is_integral_v<T> && !std::is_same_v<T, bool> && (sizeof(T) == 4 || sizeof(T) == 8))
+			|| std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+		// Searches finish with a vector scan when the sorted elements are arithmetic,
+		// stored contiguously, compared as themselves and ordered by std::less
+		template <class RndIt, class Key, class Compare, class ExtractKey>
+		constexpr bool use_simd_search_v = []() {
+			using value_t = typename std::iterator_traits<RndIt>::value_type;
+			if constexpr (is_simd_key_v<value_t>) {
+				return std::is_same_v<Key, value_t>
+					&& std::is_same_v<ExtractKey, identity<value_t>>
+					&& (std::is_same_v<Compare, std::less<value_t>> || std::is_same_v<Compare, std::less<>>)
+					&& is_contiguous_iterator_v<RndIt>;
+			}
+			else
+				return false;
+		}();
+
+		// Counts the elements of [p, p + n) that precede key, or that do not follow it when OrEqual
+		template <bool OrEqual, class T>
+		std::size_t count_before_scalar(const T* p, std::size_t n, T key) noexcept {
+			std::size_t count = 0;
+			for (std::size_t i = 0; i != n; ++i)
+				count += OrEqual ? !(key < p[i]) : p[i] < key;
+			return count;
+		}
+
+#if defined(LIBRA_X86_SIMD)
+		template <bool OrEqual, class T>
+		LIBRA_TARGET_AVX2 std::size_t count_before_avx2(const T* p, std::size_t n, T key) noexcept {
+			constexpr std::size_t lanes = 32 / sizeof(T);
+			std::size_t count = 0;
+			std::size_t i = 0;
+			if constexpr (std::is_same_v<T, float>) {
+				__m256 k = _mm256_set1_ps(key);
+				for (; i + lanes <= n; i += lanes) {
+					__m256 v = _mm256_loadu_ps(p + i);
+					count += detail::popcount(_mm256_movemask_ps(_mm256_cmp_ps(v, k, OrEqual ? _CMP_LE_OQ : _CMP_LT_OQ)));
+				}
+			}
+			else if constexpr (std::is_same_v<T, double>) {
+				__m256d k = _mm256_set1_pd(key);
+				for (; i + lanes <= n; i += lanes) {
+					__m256d v = _mm256_loadu_pd(p + i);
+					count += detail::popcount(_mm256_movemask_pd(_mm256_cmp_pd(v, k, OrEqual ? _CMP_LE_OQ : _CMP_LT_OQ)));
+				}
+			}
+			else if constexpr (sizeof(T) == 4) {
+				// AVX2 only compares signed lanes; unsigned values are biased into the signed range
+				__m256i bias = _mm256_set1_epi32(std::is_signed_v<T> ? 0 : std::numeric_limits<std::int32_t>::min());
+				__m256i k = _mm256_xor_si256(_mm256_set1_epi32(static_cast<std::int32_t>(key)), bias);
+				for (; i + lanes <= n; i += lanes) {
+					__m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), bias);
+					__m256i mask = OrEqual ? _mm256_cmpgt_epi32(v, k) : _mm256_cmpgt_epi32(k, v);
+					std::size_t bits = detail::popcount(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+					count += OrEqual ? lanes - bits : bits;
+				}
+			}
+			else {
+				__m256i bias = _mm256_set1_epi64x(std::is_signed_v<T> ? 0 : std::numeric_limits<std::int64_t>::min());
+				__m256i k = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<std::int64_t>(key)), bias);
+				for (; i + lanes <= n; i += lanes) {
+					__m256i v = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i)), bias);
+					__m256i mask = OrEqual ? _mm256_cmpgt_epi64(v, k) : _mm256_cmpgt_epi64(k, v);
+					std::size_t bits = detail::popcount(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+					count += OrEqual ? lanes - bits : bits;
+				}
+			}
+			return count + detail::count_before_scalar<OrEqual>(p + i, n - i, key);
+		}
+#endif
+
+		template <bool OrEqual, class T>
+		std::size_t count_before(const T* p, std::size_t n, T key) noexcept {
+#if defined(LIBRA_X86_SIMD)
+			if (detail::cpu_supports_avx2())
+				return detail::count_before_avx2<OrEqual>(p, n, key);
+#endif
+			return detail::count_before_scalar<OrEqual>(p, n, key);
+		}
+
+		// Branchless descent down to a couple of cache lines, then a single vector scan
+		// counting the elements ahead of the bound. Returns the lower bound of key, or the
+		// upper bound when OrEqual.
+		template <bool OrEqual, class T>
+		const T* simd_bound(const T* first, const T* last, T key) noexcept {
+			constexpr std::ptrdiff_t block = 128 / sizeof(T);
+			std::ptrdiff_t len = last - first;
+			while (len > block) {
+				std::ptrdiff_t half = len / 2;
+				std::ptrdiff_t next_half = (len - half) / 2;
+				detail::prefetch(first + next_half);
+				detail::prefetch(first + half + next_half);
+				first += (OrEqual ? !(key < first[half]) : first[half] < key) ? half : 0;
+				len -= half;
+			}
+			return first + detail::count_before<OrEqual>(first, static_cast<std::size_t>(len), key);
+		}
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace libra {
+
+	// Marks a range as already sorted with no equivalent elements
+	struct sorted_unique_t {
+		explicit sorted_unique_t() = default;
+	};
+
+	inline constexpr sorted_unique_t sorted_unique{};
+
+	// Marks a range as already sorted, possibly with equivalent elements
+	struct sorted_equivalent_t {
+		explicit sorted_equivalent_t() = default;
+	};
+
+	inline constexpr sorted_equivalent_t sorted_equivalent{};
+
+}
\ No newline at end of file
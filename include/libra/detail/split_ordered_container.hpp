@@ -0,0 +1,644 @@
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <numeric>
+#include <utility>
+#include <algorithm>
+#include "sorted_tags.hpp"
+#include "is_transparent.hpp"
+#include "memory_usage.hpp"
+#include "../algorithm/binary_search.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Random access iterator zipping a key array with a mapped array.
+		// Dereferencing yields a pair of references into both arrays.
+		template <
+			class Key,
+			class Mapped,
+			bool IsConst = false
+		> class split_iterator {
+		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type        = std::pair<Key, Mapped>;
+			using difference_type   = std::ptrdiff_t;
+			using reference = std::pair
+				<
+					const Key&,
+					std::conditional_t<IsConst, const Mapped&, Mapped&>
+				>;
+
+			// Keeps the proxy reference alive for the duration of a member access
+			class pointer {
+				reference m_ref;
+			public:
+				pointer(reference ref)
+					: m_ref(ref) {}
+				reference* operator->() noexcept { return &m_ref; }
+			};
+
+			friend class split_iterator<Key, Mapped, !IsConst>;
+
+		private:
+
+			using mapped_pointer = std::conditional_t<IsConst, const Mapped*, Mapped*>;
+
+			const Key* m_key = nullptr;
+			mapped_pointer m_mapped = nullptr;
+
+		public:
+
+			split_iterator() = default;
+
+			split_iterator(const Key* key, mapped_pointer mapped)
+				: m_key(key), m_mapped(mapped) {}
+
+			// non const to const iterator
+			template <bool is_const = IsConst, class = std::enable_if_t<is_const>>
+			split_iterator(const split_iterator<Key, Mapped, false>& it)
+				: m_key(it.m_key), m_mapped(it.m_mapped) {}
+
+			// difference operator
+
+			template <bool is_const>
+			difference_type operator-(const split_iterator<Key, Mapped, is_const>& it) const noexcept {
+				return m_key - it.m_key;
+			}
+
+			// pointer-like operators
+
+			reference operator*() const noexcept {
+				return { *m_key, *m_mapped };
+			}
+
+			pointer operator->() const noexcept {
+				return pointer(**this);
+			}
+
+			reference operator[](difference_type n) const noexcept {
+				return *(*this + n);
+			}
+
+			// increment / decrement
+
+			split_iterator& operator++() noexcept { ++m_key; ++m_mapped; return *this; }
+			split_iterator operator++(int) noexcept { split_iterator tmp(*this); ++*this; return tmp; }
+
+			split_iterator& operator--() noexcept { --m_key; --m_mapped; return *this; }
+			split_iterator operator--(int) noexcept { split_iterator tmp(*this); --*this; return tmp; }
+
+			// arithmetic
+
+			split_iterator& operator+=(difference_type n) noexcept { m_key += n; m_mapped += n; return *this; }
+			split_iterator operator+(difference_type n) const noexcept { return split_iterator(*this) += n; }
+			friend split_iterator operator+(difference_type n, const split_iterator& it) noexcept { return it + n; }
+
+			split_iterator& operator-=(difference_type n) noexcept { m_key -= n; m_mapped -= n; return *this; }
+			split_iterator operator-(difference_type n) const noexcept { return split_iterator(*this) -= n; }
+
+			// comparison
+
+			template <bool is_const>
+			bool operator==(const split_iterator<Key, Mapped, is_const>& it) const noexcept { return m_key == it.m_key; }
+
+			template <bool is_const>
+			bool operator!=(const split_iterator<Key, Mapped, is_const>& it) const noexcept { return m_key != it.m_key; }
+
+			template <bool is_const>
+			bool operator<(const split_iterator<Key, Mapped, is_const>& it) const noexcept { return m_key < it.m_key; }
+
+			template <bool is_const>
+			bool operator<=(const split_iterator<Key, Mapped, is_const>& it) const noexcept { return m_key <= it.m_key; }
+
+			template <bool is_const>
+			bool operator>(const split_iterator<Key, Mapped, is_const>& it) const noexcept { return m_key > it.m_key; }
+
+			template <bool is_const>
+			bool operator>=(const split_iterator<Key, Mapped, is_const>& it) const noexcept { return m_key >= it.m_key; }
+
+		};
+
+		template <
+			class Key,
+			class Compare
+		> class SplitValueCompare {
+			Compare m_cmp;
+		public:
+			SplitValueCompare(Compare c)
+				: m_cmp(c) {}
+			template <class Lhs, class Rhs>
+			bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+				return m_cmp(lhs.first, rhs.first);
+			}
+		};
+
+		// Ordered key/mapped container storing the keys and the mapped values in
+		// two separate sorted arrays. Searches only touch the key array.
+		template <
+			class Key,
+			class Mapped,
+			class Compare,
+			class KeyAllocator,
+			class MappedAllocator,
+			bool AllowDuplicates
+		> class split_ordered_container {
+			static_assert(!std::is_same_v<Key, bool> && !std::is_same_v<Mapped, bool>,
+				"std::vector<bool> does not provide contiguous storage");
+		public:
+
+			using key_container_type     = std::vector<Key, KeyAllocator>;
+			using mapped_container_type  = std::vector<Mapped, MappedAllocator>;
+			using key_type               = Key;
+			using mapped_type            = Mapped;
+			using value_type             = std::pair<Key, Mapped>;
+			using size_type              = typename key_container_type::size_type;
+			using difference_type        = typename key_container_type::difference_type;
+			using key_compare            = Compare;
+			using value_compare          = SplitValueCompare<Key, Compare>;
+			using iterator               = split_iterator<Key, Mapped>;
+			using const_iterator         = split_iterator<Key, Mapped, true>;
+			using reference              = typename iterator::reference;
+			using const_reference        = typename const_iterator::reference;
+			using pointer                = typename iterator::pointer;
+			using const_pointer          = typename const_iterator::pointer;
+			using reverse_iterator       = std::reverse_iterator<iterator>;
+			using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+			struct containers {
+				key_container_type keys;
+				mapped_container_type values;
+			};
+
+		private:
+
+			key_compare m_key_cmp;
+			key_container_type m_keys;
+			mapped_container_type m_values;
+
+			using emplace_return_type = std::conditional_t<AllowDuplicates, iterator, std::pair<iterator, bool>>;
+			using sorted_tag_type = std::conditional_t<AllowDuplicates, sorted_equivalent_t, sorted_unique_t>;
+			using extract_type = identity<Key>;
+
+			bool iterator_in_range(const_iterator it) const {
+				return cbegin() <= it && it <= cend();
+			}
+
+			template <class K1, class K2>
+			bool equivalent(const K1& lhs, const K2& rhs) const {
+				return !m_key_cmp(lhs, rhs) && !m_key_cmp(rhs, lhs);
+			}
+
+			bool keys_in_order(size_type first, size_type last) const {
+				auto out_of_order = [this](const key_type& lhs, const key_type& rhs) {
+					if constexpr (AllowDuplicates)
+						return m_key_cmp(rhs, lhs);
+					else
+						return !m_key_cmp(lhs, rhs);
+				};
+				return std::adjacent_find(m_keys.begin() + first, m_keys.begin() + last, out_of_order)
+					== m_keys.begin() + last;
+			}
+
+			// Returns the index within [first, last) at which an element with the given key belongs
+			size_type insert_index(const key_type& key, size_type first, size_type last) const {
+				auto kfirst = m_keys.begin() + first;
+				auto klast = m_keys.begin() + last;
+				if constexpr (AllowDuplicates) {
+					return detail::upper_bound(kfirst, klast, key, m_key_cmp, extract_type()) - m_keys.begin();
+				}
+				else {
+					return detail::lower_bound(kfirst, klast, key, m_key_cmp, extract_type()) - m_keys.begin();
+				}
+			}
+
+			iterator insert_at(size_type idx, value_type&& value) {
+				m_keys.insert(m_keys.begin() + idx, std::move(value.first));
+				try {
+					m_values.insert(m_values.begin() + idx, std::move(value.second));
+				}
+				catch (...) {
+					m_keys.erase(m_keys.begin() + idx);
+					throw;
+				}
+				return begin() + idx;
+			}
+
+			template <class... Args>
+			std::pair<iterator, bool> emplace_unique(Args&& ...args) {
+				value_type value(std::forward<Args>(args)...);
+				size_type idx = insert_index(value.first, 0, size());
+				if (idx != size() && equivalent(m_keys[idx], value.first))
+					return { begin() + idx, false };
+				return { insert_at(idx, std::move(value)), true };
+			}
+
+			template <class... Args>
+			iterator emplace_common(Args&& ...args) {
+				value_type value(std::forward<Args>(args)...);
+				return insert_at(insert_index(value.first, 0, size()), std::move(value));
+			}
+
+			template <class... Args>
+			iterator emplace_hint_impl(const_iterator hint, Args&& ...args) {
+				assert(iterator_in_range(hint) && "Iterator out of range!");
+				value_type value(std::forward<Args>(args)...);
+				const key_type& key = value.first;
+				size_type pos = hint - cbegin();
+				size_type idx;
+				if (pos != size() && !m_key_cmp(key, m_keys[pos]))
+					idx = insert_index(key, pos, size());
+				else if (pos == 0 || (AllowDuplicates ? !m_key_cmp(key, m_keys[pos - 1]) : m_key_cmp(m_keys[pos - 1], key)))
+					idx = pos;
+				else
+					idx = insert_index(key, 0, pos);
+				if constexpr (!AllowDuplicates) {
+					if (idx != size() && equivalent(m_keys[idx], key))
+						return begin() + idx;
+				}
+				return insert_at(idx, std::move(value));
+			}
+
+			// Sorts the elements appended past the first n and merges them into the sorted prefix
+			void merge_back(size_type n) {
+				if (n == size())
+					return;
+				std::vector<size_type> order(size());
+				std::iota(order.begin(), order.end(), size_type(0));
+				auto middle = order.begin() + n;
+				auto key_less = [this](size_type lhs, size_type rhs) {
+					return m_key_cmp(m_keys[lhs], m_keys[rhs]);
+				};
+				if (!std::is_sorted(middle, order.end(), key_less))
+					std::stable_sort(middle, order.end(), key_less);
+				if (n != 0 && m_key_cmp(m_keys[*middle], m_keys[n - 1]))
+					std::inplace_merge(order.begin(), middle, order.end(), key_less);
+				if constexpr (!AllowDuplicates) {
+					auto same_key = [this](size_type lhs, size_type rhs) {
+						return !m_key_cmp(m_keys[lhs], m_keys[rhs]);
+					};
+					order.erase(std::unique(order.begin(), order.end(), same_key), order.end());
+				}
+				if (std::is_sorted(order.begin(), order.end()) && order.size() == size())
+					return;
+				key_container_type keys(m_keys.get_allocator());
+				mapped_container_type values(m_values.get_allocator());
+				keys.reserve(order.size());
+				values.reserve(order.size());
+				for (size_type idx : order) {
+					keys.emplace_back(std::move(m_keys[idx]));
+					values.emplace_back(std::move(m_values[idx]));
+				}
+				m_keys = std::move(keys);
+				m_values = std::move(values);
+			}
+
+		public:
+
+			// ctor
+			split_ordered_container()
+				: split_ordered_container(Compare()) {}
+
+			explicit split_ordered_container(const Compare& comp)
+				: m_key_cmp(comp) {}
+
+			template <class InIt>
+			split_ordered_container(InIt first, InIt last, const Compare& comp = Compare())
+				: split_ordered_container(comp)
+			{
+				insert(first, last);
+			}
+
+			template <class InIt>
+			split_ordered_container(sorted_tag_type tag, InIt first, InIt last, const Compare& comp = Compare())
+				: split_ordered_container(comp)
+			{
+				insert(tag, first, last);
+			}
+
+			split_ordered_container(std::initializer_list<value_type> list, const Compare& comp = Compare())
+				: split_ordered_container(list.begin(), list.end(), comp) {}
+
+			split_ordered_container(sorted_tag_type tag, std::initializer_list<value_type> list, const Compare& comp = Compare())
+				: split_ordered_container(tag, list.begin(), list.end(), comp) {}
+
+			split_ordered_container(const split_ordered_container&) = default;
+			split_ordered_container(split_ordered_container&&) = default;
+
+			// dtor
+			~split_ordered_container() = default;
+
+			// assignment
+			split_ordered_container& operator=(const split_ordered_container&) = default;
+			split_ordered_container& operator=(split_ordered_container&&) = default;
+			split_ordered_container& operator=(std::initializer_list<value_type> list) {
+				clear();
+				insert(list);
+				return *this;
+			}
+
+			// iterators
+			iterator begin() noexcept { return iterator(m_keys.data(), m_values.data()); }
+			const_iterator begin() const noexcept { return const_iterator(m_keys.data(), m_values.data()); }
+			const_iterator cbegin() const noexcept { return begin(); }
+
+			iterator end() noexcept { return begin() + size(); }
+			const_iterator end() const noexcept { return begin() + size(); }
+			const_iterator cend() const noexcept { return end(); }
+
+			reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+			const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+			const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+			reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+			const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+			const_reverse_iterator crend() const noexcept { return rend(); }
+
+			// capacity
+			bool empty() const noexcept { return m_keys.empty(); }
+			size_type size() const noexcept { return m_keys.size(); }
+			size_type max_size() const noexcept { return std::min(m_keys.max_size(), m_values.max_size()); }
+			size_type capacity() const noexcept { return std::min(m_keys.capacity(), m_values.capacity()); }
+			void reserve(size_type new_cap) { m_keys.reserve(new_cap); m_values.reserve(new_cap); }
+			void shrink_to_fit() { m_keys.shrink_to_fit(); m_values.shrink_to_fit(); }
+
+			// memory, see libra::memory_footprint
+			size_type allocated_bytes() const noexcept {
+				return vector_bytes(m_keys) + vector_bytes(m_values);
+			}
+
+			size_type wasted_capacity() const noexcept {
+				return allocated_bytes() - size() * (sizeof(key_type) + sizeof(mapped_type));
+			}
+
+			memory_footprint memory_usage() const {
+				memory_footprint usage = make_footprint(allocated_bytes(), size() * sizeof(key_type), m_keys.begin(), m_keys.end());
+				usage += make_footprint(0, size() * sizeof(mapped_type), m_values.begin(), m_values.end());
+				return usage;
+			}
+
+			// modifiers
+			void clear() noexcept { m_keys.clear(); m_values.clear(); }
+
+			emplace_return_type insert(const value_type& value) { return emplace(value); }
+			emplace_return_type insert(value_type&& value) { return emplace(std::move(value)); }
+
+			iterator insert(const_iterator hint, const value_type& value) { return emplace_hint(hint, value); }
+			iterator insert(const_iterator hint, value_type&& value) { return emplace_hint(hint, std::move(value)); }
+
+			template <class InIt>
+			void insert(InIt first, InIt last) {
+				size_type n = size();
+				for (; first != last; ++first) {
+					value_type value(*first);
+					m_keys.emplace_back(std::move(value.first));
+					m_values.emplace_back(std::move(value.second));
+				}
+				merge_back(n);
+			}
+
+			void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+			template <class InIt>
+			void insert(sorted_tag_type, InIt first, InIt last) {
+				size_type n = size();
+				for (; first != last; ++first) {
+					value_type value(*first);
+					m_keys.emplace_back(std::move(value.first));
+					m_values.emplace_back(std::move(value.second));
+				}
+				assert(keys_in_order(n, size()) && "Range is not sorted!");
+				merge_back(n);
+			}
+
+			void insert(sorted_tag_type tag, std::initializer_list<value_type> list) {
+				insert(tag, list.begin(), list.end());
+			}
+
+			template <class... Args>
+			emplace_return_type emplace(Args&&... args) {
+				if constexpr (AllowDuplicates) {
+					return emplace_common(std::forward<Args>(args)...);
+				}
+				else {
+					return emplace_unique(std::forward<Args>(args)...);
+				}
+			}
+
+			template <class... Args>
+			iterator emplace_hint(const_iterator hint, Args&&... args) {
+				return emplace_hint_impl(hint, std::forward<Args>(args)...);
+			}
+
+			iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+			iterator erase(const_iterator first, const_iterator last) {
+				difference_type idx = first - cbegin();
+				difference_type count = last - first;
+				m_keys.erase(m_keys.begin() + idx, m_keys.begin() + idx + count);
+				m_values.erase(m_values.begin() + idx, m_values.begin() + idx + count);
+				return begin() + idx;
+			}
+
+			size_type erase(const key_type& key) {
+				auto range = equal_range(key);
+				auto count = range.second - range.first;
+				if (count > 0)
+					erase(range.first, range.second);
+				return count;
+			}
+
+			// Moves both sorted arrays out of the container, leaving it empty
+			containers extract() && {
+				containers data{ std::move(m_keys), std::move(m_values) };
+				clear();
+				return data;
+			}
+
+			// Adopts arrays of equal length whose keys are already sorted
+			void replace(key_container_type&& keys, mapped_container_type&& values) {
+				assert(keys.size() == values.size() && "Mismatched key and mapped arrays!");
+				m_keys = std::move(keys);
+				m_values = std::move(values);
+				assert(keys_in_order(0, size()) && "Storage is not sorted!");
+			}
+
+			void swap(split_ordered_container& other)
+				noexcept(std::is_nothrow_swappable<Compare>::value)
+			{
+				if (this != &other) {
+					std::swap(m_key_cmp, other.m_key_cmp);
+					std::swap(m_keys, other.m_keys);
+					std::swap(m_values, other.m_values);
+				}
+			}
+
+			// lookup
+			size_type count(const key_type& key) const {
+				auto range = equal_range(key);
+				return range.second - range.first;
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, size_type>
+				count(const K& key) const {
+				auto range = equal_range(key);
+				return range.second - range.first;
+			}
+
+			iterator find(const key_type& key) {
+				auto lower = lower_bound(key);
+				return lower != end() && equivalent(lower->first, key) ? lower : end();
+			}
+
+			const_iterator find(const key_type& key) const {
+				auto lower = lower_bound(key);
+				return lower != end() && equivalent(lower->first, key) ? lower : end();
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				find(const K& key) {
+				auto lower = lower_bound(key);
+				return lower != end() && equivalent(lower->first, key) ? lower : end();
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				find(const K& key) const {
+				auto lower = lower_bound(key);
+				return lower != end() && equivalent(lower->first, key) ? lower : end();
+			}
+
+			bool contains(const key_type& key) const {
+				return find(key) != end();
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, bool>
+				contains(const K& key) const {
+				return find(key) != end();
+			}
+
+			std::pair<iterator, iterator> equal_range(const key_type& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<iterator, iterator>>
+				equal_range(const K& key) {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, std::pair<const_iterator, const_iterator>>
+				equal_range(const K& key) const {
+				return { lower_bound(key), upper_bound(key) };
+			}
+
+			iterator lower_bound(const key_type& key) {
+				return begin() + (detail::lower_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, extract_type()) - m_keys.begin());
+			}
+
+			const_iterator lower_bound(const key_type& key) const {
+				return begin() + (detail::lower_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, extract_type()) - m_keys.begin());
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				lower_bound(const K& key) {
+				return begin() + (detail::lower_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, extract_type()) - m_keys.begin());
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				lower_bound(const K& key) const {
+				return begin() + (detail::lower_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, extract_type()) - m_keys.begin());
+			}
+
+			iterator upper_bound(const key_type& key) {
+				return begin() + (detail::upper_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, extract_type()) - m_keys.begin());
+			}
+
+			const_iterator upper_bound(const key_type& key) const {
+				return begin() + (detail::upper_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, extract_type()) - m_keys.begin());
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, iterator>
+				upper_bound(const K& key) {
+				return begin() + (detail::upper_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, extract_type()) - m_keys.begin());
+			}
+
+			template <class K>
+			std::enable_if_t<is_transparent_v<K, Compare>, const_iterator>
+				upper_bound(const K& key) const {
+				return begin() + (detail::upper_bound(m_keys.begin(), m_keys.end(), key, m_key_cmp, extract_type()) - m_keys.begin());
+			}
+
+			// observers
+			key_compare key_comp() const { return m_key_cmp; }
+			value_compare value_comp() const { return value_compare(m_key_cmp); }
+			const key_container_type& keys() const noexcept { return m_keys; }
+			const mapped_container_type& values() const noexcept { return m_values; }
+
+		};
+
+		template <class Key, class Mapped, class Compare, class KeyAllocator, class MappedAllocator, bool AllowDuplicates>
+		bool operator==(
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& lhs,
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& rhs)
+		{
+			auto comp = lhs.key_comp();
+			auto equal = [&comp](const auto& lhs, const auto& rhs) {
+				return !comp(lhs, rhs) && !comp(rhs, lhs);
+			};
+			return std::equal(lhs.keys().begin(), lhs.keys().end(), rhs.keys().begin(), rhs.keys().end(), equal);
+		}
+
+		template <class Key, class Mapped, class Compare, class KeyAllocator, class MappedAllocator, bool AllowDuplicates>
+		bool operator!=(
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& lhs,
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& rhs)
+		{
+			return !(lhs == rhs);
+		}
+
+		template <class Key, class Mapped, class Compare, class KeyAllocator, class MappedAllocator, bool AllowDuplicates>
+		bool operator<(
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& lhs,
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& rhs)
+		{
+			return std::lexicographical_compare(lhs.keys().begin(), lhs.keys().end(), rhs.keys().begin(), rhs.keys().end(), lhs.key_comp());
+		}
+
+		template <class Key, class Mapped, class Compare, class KeyAllocator, class MappedAllocator, bool AllowDuplicates>
+		bool operator<=(
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& lhs,
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& rhs)
+		{
+			return !(rhs < lhs);
+		}
+
+		template <class Key, class Mapped, class Compare, class KeyAllocator, class MappedAllocator, bool AllowDuplicates>
+		bool operator>(
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& lhs,
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& rhs)
+		{
+			return rhs < lhs;
+		}
+
+		template <class Key, class Mapped, class Compare, class KeyAllocator, class MappedAllocator, bool AllowDuplicates>
+		bool operator>=(
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& lhs,
+			const split_ordered_container<Key, Mapped, Compare, KeyAllocator, MappedAllocator, AllowDuplicates>& rhs)
+		{
+			return !(lhs < rhs);
+		}
+
+	}
+}
\ No newline at end of file
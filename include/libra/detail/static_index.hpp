@@ -0,0 +1,131 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include "simd_search.hpp"
+#include "extract_key.hpp"
+
+namespace libra {
+	namespace detail {
+
+		// Implicit, read-only B+ tree (S-tree) over the keys of a sorted array. Each level
+		// stores the largest key of every block of node_size entries of the level below, and
+		// the bottom level indexes the array itself. Nodes are cache line aligned and are
+		// searched with one vector compare for arithmetic keys, so a lookup touches about
+		// log16(n) nodes rather than the log2(n) cache lines of a binary search.
+		template <
+			class Key,
+			class Compare,
+			class Allocator
+		> class static_index {
+		public:
+
+			static constexpr std::size_t node_size = 16;
+			static constexpr bool supported = std::is_default_constructible_v<Key> && std::is_copy_assignable_v<Key>;
+
+		private:
+
+			struct alignas(64) node {
+				Key keys[node_size];
+			};
+
+			struct level {
+				std::size_t offset; // index of the level's first node
+				std::size_t size; // number of keys on the level
+			};
+
+			using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+			using level_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<level>;
+
+			std::vector<node, node_allocator> m_nodes;
+			std::vector<level, level_allocator> m_levels; // bottom level first
+			bool m_enabled = false;
+
+			// Counts the entries of [p, p + n) ordered before key, or not after it when Upper
+			template <bool Upper, class Value, class K, class ExtractKey>
+			static std::size_t count_in(const Value* p, std::size_t n, const K& key, const Compare& comp, const ExtractKey& extract) {
+				if constexpr (use_simd_search_v<const Value*, K, Compare, ExtractKey>) {
+					return detail::count_before<Upper>(p, n, key);
+				}
+				else {
+					std::size_t count = 0;
+					for (std::size_t i = 0; i != n; ++i)
+						count += Upper ? !comp(key, extract(p[i])) : comp(extract(p[i]), key);
+					return count;
+				}
+			}
+
+			const Key& key_at(const level& lvl, std::size_t i) const {
+				return m_nodes[lvl.offset + i / node_size].keys[i % node_size];
+			}
+
+		public:
+
+			static_index() = default;
+
+			explicit static_index(const Allocator& alloc)
+				: m_nodes(node_allocator(alloc))
+				, m_levels(level_allocator(alloc)) {}
+
+			bool enabled() const noexcept {
+				return m_enabled;
+			}
+
+			std::size_t allocated_bytes() const noexcept {
+				return m_nodes.capacity() * sizeof(node) + m_levels.capacity() * sizeof(level);
+			}
+
+			// Indexes the n sorted elements at data. Linear in n / node_size.
+			template <class Value, class ExtractKey>
+			void build(const Value* data, std::size_t n, const ExtractKey& extract) {
+				if constexpr (supported) {
+					m_nodes.clear();
+					m_levels.clear();
+					m_enabled = false;
+					std::size_t below = n;
+					while (below > node_size) {
+						std::size_t keys = (below + node_size - 1) / node_size;
+						std::size_t nodes = (keys + node_size - 1) / node_size;
+						std::size_t offset = m_nodes.size();
+						m_nodes.resize(offset + nodes);
+						for (std::size_t i = 0; i != nodes * node_size; ++i) {
+							// entries past the end of the level repeat its largest key
+							std::size_t last = std::min((std::min(i, keys - 1) + 1) * node_size, below) - 1;
+							m_nodes[offset + i / node_size].keys[i % node_size] =
+								m_levels.empty() ? extract(data[last]) : key_at(m_levels.back(), last);
+						}
+						m_levels.push_back({ offset, keys });
+						below = keys;
+					}
+					m_enabled = true;
+				}
+			}
+
+			void reset() noexcept {
+				m_nodes.clear();
+				m_levels.clear();
+				m_enabled = false;
+			}
+
+			// Position of the lower bound of key among the n elements at data, or of its
+			// upper bound when Upper
+			template <bool Upper, class Value, class K, class ExtractKey>
+			std::size_t bound(const Value* data, std::size_t n, const K& key, const Compare& comp, const ExtractKey& extract) const {
+				std::size_t block = 0;
+				for (auto lvl = m_levels.rbegin(); lvl != m_levels.rend(); ++lvl) {
+					const node& nd = m_nodes[lvl->offset + block];
+					block = block * node_size + count_in<Upper>(nd.keys, node_size, key, comp, identity<Key>{});
+					if (block >= lvl->size)
+						return n;
+				}
+				std::size_t first = block * node_size;
+				return first + count_in<Upper>(data + first, std::min(node_size, n - first), key, comp, extract);
+			}
+
+		};
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+namespace libra {
+
+	// Stats policies observe the work a container does. The container owns one policy
+	// object, reports to it through the hooks below and exposes it through stats(). The
+	// record belongs to the container object rather than to its elements: swap() exchanges
+	// the elements but leaves each container's stats in place.
+
+	// Records nothing, the default. Every hook compiles away.
+	struct no_stats {
+		void on_compare(std::size_t) noexcept {}
+		void on_move(std::size_t) noexcept {}
+		void on_allocate(std::size_t) noexcept {}
+		void on_rotate(std::size_t) noexcept {}
+	};
+
+	// Counts comparisons, element moves, allocations and rotations. The sort and the merge
+	// of a bulk insert report one move per element they span; the temporary buffers the
+	// standard library may allocate for them are not reported.
+	struct counting_stats {
+		std::size_t comparisons = 0;
+		std::size_t moves = 0;
+		std::size_t allocations = 0;
+		std::size_t bytes_allocated = 0;
+		std::size_t rotations = 0;
+		std::size_t rotate_distance = 0; // elements spanned by all rotations
+
+		void on_compare(std::size_t n) noexcept { comparisons += n; }
+		void on_move(std::size_t n) noexcept { moves += n; }
+
+		void on_allocate(std::size_t bytes) noexcept {
+			++allocations;
+			bytes_allocated += bytes;
+		}
+
+		void on_rotate(std::size_t distance) noexcept {
+			++rotations;
+			rotate_distance += distance;
+		}
+
+		void reset() noexcept { *this = counting_stats(); }
+	};
+
+	namespace detail {
+
+		template <class Stats>
+		constexpr bool records_stats_v = !std::is_same_v<Stats, no_stats>;
+
+		// Holds a container's stats policy. An empty policy is kept as a base so that it
+		// takes no space. Const lookups report to the policy too, hence observer().
+		template <
+			class Stats,
+			bool = std::is_empty_v<Stats>
+		> class stats_holder {
+			mutable Stats m_stats;
+		public:
+			Stats& stats() noexcept { return m_stats; }
+			const Stats& stats() const noexcept { return m_stats; }
+		protected:
+			Stats& observer() const noexcept { return m_stats; }
+		};
+
+		template <class Stats>
+		class stats_holder<Stats, true> : private Stats {
+		public:
+			Stats& stats() noexcept { return *this; }
+			const Stats& stats() const noexcept { return *this; }
+		protected:
+			Stats& observer() const noexcept { return const_cast<stats_holder&>(*this); }
+		};
+
+		// Comparator reporting Cost comparisons to a stats policy per call
+		template <
+			class Compare,
+			class Stats,
+			std::size_t Cost = 1
+		> class observed_compare {
+			const Compare* m_cmp;
+			Stats* m_stats;
+		public:
+			observed_compare(const Compare& cmp, Stats& stats)
+				: m_cmp(&cmp), m_stats(&stats) {}
+
+			template <class Lhs, class Rhs>
+			bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+				m_stats->on_compare(Cost);
+				return (*m_cmp)(lhs, rhs);
+			}
+		};
+
+	}
+}
\ No newline at end of file
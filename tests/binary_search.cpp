@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
+#include <array>
+#include <string>
 #include <vector>
+#include <cstdint>
 #include <cstdlib>
 #include <algorithm>
 #include "detail/constants.hpp"
@@ -15,6 +18,7 @@ TEST(BinarySearchTests, LowerBoundTest) {
 	ASSERT_EQ(std_lower, lower);
 	for (auto i = 0; i != N; ++i) {
 		std::generate(nums.begin(), nums.end(), []() { return std::rand() % 100 + 1;  });
+		std::sort(nums.begin(), nums.end());
 		auto idx = std::rand() % nums.size();
 		auto std_lower = std::lower_bound(nums.begin(), nums.end(), nums[idx]);
 		auto lower = libra::lower_bound(nums.begin(), nums.end(), nums[idx]);
@@ -32,6 +36,7 @@ TEST(BinarySearchTests, UpperBoundTest) {
 	ASSERT_EQ(std_upper, upper);
 	for (auto i = 0; i != N; ++i) {
 		std::generate(nums.begin(), nums.end(), []() { return std::rand() % 100 + 1;  });
+		std::sort(nums.begin(), nums.end());
 		auto idx = std::rand() % nums.size();
 		std_upper = std::upper_bound(nums.begin(), nums.end(), nums[idx]);
 		upper = libra::upper_bound(nums.begin(), nums.end(), nums[idx]);
@@ -49,6 +54,7 @@ TEST(BinarySearchTests, BinarySearchTest) {
 	ASSERT_EQ(std_bs, bs);
 	for (auto i = 0; i != N; ++i) {
 		std::generate(nums.begin(), nums.end(), []() { return std::rand() % 100 + 1;  });
+		std::sort(nums.begin(), nums.end());
 		auto idx = std::rand() % nums.size();
 		std_bs = std::binary_search(nums.begin(), nums.end(), nums[idx]);
 		bs = libra::binary_search(nums.begin(), nums.end(), nums[idx]);
@@ -67,10 +73,134 @@ TEST(BinarySearchTests, EqualRangeTests) {
 	ASSERT_EQ(std_eq_rng.second, eq_rng.second);
 	for (auto i = 0; i != N; ++i) {
 		std::generate(nums.begin(), nums.end(), []() { return std::rand() % 100 + 1;  });
+		std::sort(nums.begin(), nums.end());
 		auto idx = std::rand() % nums.size();
 		std_eq_rng = std::equal_range(nums.begin(), nums.end(), nums[idx]);
 		eq_rng = libra::equal_range(nums.begin(), nums.end(), nums[idx]);
 		ASSERT_EQ(std_eq_rng.first, eq_rng.first);
 		ASSERT_EQ(std_eq_rng.second, eq_rng.second);
 	}
+}
+
+TEST(BinarySearchTests, ExhaustiveBoundsTests) {
+	// Every size up to 2N, every gap and every duplicate run
+	for (int size = 0; size <= 2 * N; ++size) {
+		std::vector<int> nums(size);
+		std::generate(nums.begin(), nums.end(), [n = 0]() mutable { return n++ / 3 * 2; });
+		for (int key = -1; key <= size; ++key) {
+			ASSERT_EQ(std::lower_bound(nums.begin(), nums.end(), key), libra::lower_bound(nums.begin(), nums.end(), key));
+			ASSERT_EQ(std::upper_bound(nums.begin(), nums.end(), key), libra::upper_bound(nums.begin(), nums.end(), key));
+			ASSERT_EQ(std::lower_bound(nums.rbegin(), nums.rend(), key, std::greater<>{}),
+				libra::lower_bound(nums.rbegin(), nums.rend(), key, std::greater<>{}));
+		}
+	}
+
+	// Non-scalar keys go through the classic loop
+	std::vector<std::string> words;
+	for (int i = 0; i < N; ++i)
+		words.emplace_back(std::to_string(i));
+	std::sort(words.begin(), words.end());
+	for (const auto& word : words) {
+		ASSERT_EQ(std::lower_bound(words.begin(), words.end(), word), libra::lower_bound(words.begin(), words.end(), word));
+		ASSERT_EQ(std::upper_bound(words.begin(), words.end(), word), libra::upper_bound(words.begin(), words.end(), word));
+	}
+}
+
+template <class T>
+void check_simd_bounds(T offset) {
+	// Values straddle zero, or the sign bit for unsigned types, to exercise the lane bias
+	for (int size = 0; size <= 300; size += size < 40 ? 1 : 37) {
+		std::vector<T> nums(size);
+		std::generate(nums.begin(), nums.end(), [n = 0, offset]() mutable { return static_cast<T>(n++ / 3 * 2) + offset; });
+		for (int i = -1; i <= size; ++i) {
+			T key = static_cast<T>(i) + offset;
+			ASSERT_EQ(std::lower_bound(nums.begin(), nums.end(), key), libra::lower_bound(nums.begin(), nums.end(), key));
+			ASSERT_EQ(std::upper_bound(nums.begin(), nums.end(), key), libra::upper_bound(nums.begin(), nums.end(), key));
+			ASSERT_EQ(std::lower_bound(nums.data(), nums.data() + size, key, std::less<T>{}),
+				libra::lower_bound(nums.data(), nums.data() + size, key, std::less<T>{}));
+			ASSERT_EQ(libra::detail::count_before_scalar<false>(nums.data(), nums.size(), key),
+				libra::detail::count_before<false>(nums.data(), nums.size(), key));
+			ASSERT_EQ(libra::detail::count_before_scalar<true>(nums.data(), nums.size(), key),
+				libra::detail::count_before<true>(nums.data(), nums.size(), key));
+		}
+	}
+}
+
+TEST(BinarySearchTests, SimdBoundsTests) {
+	static_assert(libra::detail::use_simd_search_v<std::vector<int>::iterator, int, std::less<>, libra::detail::identity<int>>);
+	static_assert(libra::detail::use_simd_search_v<const double*, double, std::less<double>, libra::detail::identity<double>>);
+	static_assert(!libra::detail::use_simd_search_v<std::vector<int>::reverse_iterator, int, std::less<>, libra::detail::identity<int>>);
+	static_assert(!libra::detail::use_simd_search_v<std::vector<int>::iterator, int, std::greater<>, libra::detail::identity<int>>);
+	static_assert(!libra::detail::use_simd_search_v<std::vector<short>::iterator, short, std::less<>, libra::detail::identity<short>>);
+	check_simd_bounds<std::int32_t>(-100);
+	check_simd_bounds<std::uint32_t>(0x7fffff80u);
+	check_simd_bounds<std::int64_t>(-100);
+	check_simd_bounds<std::uint64_t>(0x7fffffffffffff80ull);
+	check_simd_bounds<float>(-100.5f);
+	check_simd_bounds<double>(-100.5);
+}
+
+TEST(BinarySearchTests, BatchBoundsTests) {
+	std::vector<int> nums(3 * N);
+	std::generate(nums.begin(), nums.end(), [n = 0]() mutable { return n++ / 3 * 2; });
+	std::vector<int> keys;
+	for (int key = -1; key <= 2 * N + 1; ++key)
+		keys.emplace_back(key);
+	for (int pass = 0; pass != 2; ++pass) {
+		std::vector<std::vector<int>::iterator> lower, upper;
+		libra::lower_bound_many(nums.begin(), nums.end(), keys.begin(), keys.end(), std::back_inserter(lower));
+		libra::upper_bound_many(nums.begin(), nums.end(), keys.begin(), keys.end(), std::back_inserter(upper));
+		ASSERT_EQ(keys.size(), lower.size());
+		for (std::size_t i = 0; i != keys.size(); ++i) {
+			ASSERT_EQ(std::lower_bound(nums.begin(), nums.end(), keys[i]), lower[i]);
+			ASSERT_EQ(std::upper_bound(nums.begin(), nums.end(), keys[i]), upper[i]);
+		}
+		std::reverse(keys.begin(), keys.end());
+	}
+
+	std::vector<int> empty;
+	std::vector<std::vector<int>::iterator> bounds;
+	libra::lower_bound_many(empty.begin(), empty.end(), keys.begin(), keys.end(), std::back_inserter(bounds));
+	ASSERT_TRUE(std::all_of(bounds.begin(), bounds.end(), [&](auto it) { return it == empty.end(); }));
+}
+
+TEST(BinarySearchTests, LongRunEqualRangeTests) {
+	// Runs of every length up to N, including one spanning the whole range
+	for (int run = 1; run <= N; ++run) {
+		std::vector<int> nums;
+		for (int i = 0; i < 3 * N; ++i)
+			nums.emplace_back(i / run);
+		for (int key = -1; key <= 3 * N / run + 1; ++key) {
+			auto expected = std::equal_range(nums.begin(), nums.end(), key);
+			ASSERT_EQ(expected, libra::equal_range(nums.begin(), nums.end(), key));
+		}
+	}
+	std::vector<int> same(4 * N, 7);
+	ASSERT_EQ(std::make_pair(same.begin(), same.end()), libra::equal_range(same.begin(), same.end(), 7));
+}
+
+TEST(BinarySearchTests, ExponentialSearchTests) {
+	// Every size up to N, every hint and every key
+	for (int size = 0; size <= N; ++size) {
+		std::vector<int> nums(size);
+		std::generate(nums.begin(), nums.end(), [n = 0]() mutable { return n++ / 3 * 2; });
+		for (int hint = 0; hint <= size; ++hint) {
+			for (int key = -1; key <= size; ++key) {
+				ASSERT_EQ(std::lower_bound(nums.begin(), nums.end(), key),
+					libra::exponential_search(nums.begin(), nums.end(), nums.begin() + hint, key));
+				ASSERT_EQ(std::upper_bound(nums.begin(), nums.end(), key), libra::detail::exponential_bound<true>(
+					nums.begin(), nums.begin() + hint, nums.end(), key, std::less<>{}, libra::detail::identity<int>{}));
+			}
+		}
+	}
+}
+
+TEST(BinarySearchTests, ConstexprTests) {
+	constexpr std::array<int, 7> nums{ 1, 2, 2, 2, 5, 8, 9 };
+	static_assert(libra::lower_bound(nums.begin(), nums.end(), 2) == nums.begin() + 1);
+	static_assert(libra::upper_bound(nums.begin(), nums.end(), 2) == nums.begin() + 4);
+	static_assert(libra::binary_search(nums.begin(), nums.end(), 8));
+	static_assert(!libra::binary_search(nums.begin(), nums.end(), 7));
+	static_assert(libra::exponential_search(nums.begin(), nums.end(), nums.end(), 2) == nums.begin() + 1);
+	static_assert(libra::equal_range(nums.begin(), nums.end(), 2).second == nums.begin() + 4);
 }
\ No newline at end of file
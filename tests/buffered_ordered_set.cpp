@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/buffered_ordered_set.hpp"
+#include "detail/constants.hpp"
+#include <set>
+#include <random>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+using set_type = libra::buffered_ordered_set<int>;
+
+std::mt19937 gen{ std::random_device{}() };
+
+TEST(BufferedOrderedSetTests, ConstructorTests) {
+	set_type s1;
+	ASSERT_TRUE(s1.empty());
+	ASSERT_EQ(s1.begin(), s1.end());
+
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+
+	// Test constructor from external container with duplicates
+	auto copy(integers);
+	integers.insert(integers.end(), copy.begin(), copy.end());
+	set_type s2(integers.begin(), integers.end());
+	ASSERT_EQ(N, s2.size());
+	ASSERT_TRUE(std::is_sorted(s2.begin(), s2.end()));
+	ASSERT_EQ(s2.end(), std::adjacent_find(s2.begin(), s2.end()));
+
+	// Test construction from a sorted range
+	std::sort(copy.begin(), copy.end());
+	set_type s3(libra::sorted_unique, copy.begin(), copy.end());
+	ASSERT_EQ(s2, s3);
+
+	// Test copy and move construction
+	set_type copier(s3);
+	ASSERT_EQ(s3, copier);
+	set_type thief(std::move(copier));
+	ASSERT_TRUE(copier.empty());
+	ASSERT_EQ(s3, thief);
+
+	// Test assignment
+	s1 = { 3, 1, 2, 3 };
+	ASSERT_EQ(set_type({ 1, 2, 3 }), s1);
+}
+
+TEST(BufferedOrderedSetTests, InsertionTests) {
+	set_type set;
+	set.set_buffer_limit(8);
+	std::set<int> expected;
+	std::vector<int> integers(4 * N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+
+	// Test that inserts are buffered, merged once the buffer is full, and always iterate in order
+	for (auto integer : integers) {
+		auto ret = set.insert(integer);
+		ASSERT_TRUE(ret.second);
+		ASSERT_EQ(integer, *ret.first);
+		ASSERT_FALSE(set.insert(integer).second);
+		ASSERT_LE(set.buffer_size(), set.buffer_limit());
+		expected.insert(integer);
+		ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+		ASSERT_TRUE(std::equal(expected.rbegin(), expected.rend(), set.rbegin(), set.rend()));
+	}
+	ASSERT_EQ(4 * N, set.size());
+
+	set.flush();
+	ASSERT_EQ(0, set.buffer_size());
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	// Test range insertion while elements are buffered
+	set.insert(-1);
+	set.insert(integers.begin(), integers.end());
+	set.insert({ -2, 4 * N });
+	ASSERT_EQ(4 * N + 3, set.size());
+	ASSERT_EQ(-2, *set.begin());
+	ASSERT_TRUE(std::is_sorted(set.begin(), set.end()));
+
+	// Test the adaptive buffer limit
+	set.set_buffer_limit(0);
+	ASSERT_EQ(set_type::min_buffer_limit, set.buffer_limit());
+}
+
+TEST(BufferedOrderedSetTests, ErasureTests) {
+	set_type set;
+	set.set_buffer_limit(8);
+	std::set<int> expected;
+	std::vector<int> integers(2 * N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+	for (auto integer : integers) {
+		set.insert(integer);
+		expected.insert(integer);
+	}
+
+	// Erase from both the main array and the insert buffer
+	for (int i = 0; i < 2 * N; i += 3) {
+		ASSERT_EQ(1, set.erase(i));
+		ASSERT_EQ(0, set.erase(i));
+		expected.erase(i);
+	}
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	auto it = set.erase(set.find(4));
+	ASSERT_EQ(5, *it);
+	it = set.erase(set.lower_bound(10), set.lower_bound(20));
+	ASSERT_EQ(20, *it);
+	expected.erase(4);
+	expected.erase(expected.lower_bound(10), expected.lower_bound(20));
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	while (!set.empty())
+		ASSERT_EQ(set.begin(), set.erase(set.begin()));
+}
+
+TEST(BufferedOrderedSetTests, LookupTests) {
+	set_type set;
+	set.set_buffer_limit(16);
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+	for (auto integer : integers)
+		set.insert(integer);
+	ASSERT_NE(0, set.buffer_size());
+
+	std::sort(integers.begin(), integers.end());
+	for (int key = -1; key <= 2 * N; ++key) {
+		auto lower = std::lower_bound(integers.begin(), integers.end(), key);
+		auto upper = std::upper_bound(integers.begin(), integers.end(), key);
+		ASSERT_EQ(lower - integers.begin(), std::distance(set.begin(), set.lower_bound(key)));
+		ASSERT_EQ(upper - integers.begin(), std::distance(set.begin(), set.upper_bound(key)));
+		ASSERT_EQ(key % 2 == 0 && key >= 0 && key < 2 * N, set.contains(key));
+		ASSERT_EQ(set.contains(key) ? 1 : 0, set.count(key));
+		ASSERT_EQ(set.contains(key) ? set.lower_bound(key) : set.end(), set.find(key));
+	}
+
+	// Test heterogeneous lookup
+	libra::buffered_ordered_set<std::string, std::less<>> words({ "alpha", "beta" });
+	words.insert("gamma");
+	ASSERT_TRUE(words.contains("gamma"));
+	ASSERT_EQ("gamma", *words.upper_bound("beta"));
+}
+
+TEST(BufferedOrderedSetTests, ExtractReplaceTests) {
+	set_type set({ 1, 3 });
+	set.insert(2);
+	ASSERT_EQ(1, set.buffer_size());
+	auto data = std::move(set).extract();
+	ASSERT_TRUE(set.empty());
+	ASSERT_EQ(std::vector<int>({ 1, 2, 3 }), data);
+
+	set.replace(std::move(data));
+	ASSERT_EQ(set_type({ 1, 2, 3 }), set);
+}
+
+TEST(BufferedOrderedSetTests, LexicographicalTests) {
+	set_type set({ 1, 3 });
+	set.insert(2);
+	ASSERT_EQ(set_type({ 1, 2, 3 }), set);
+	ASSERT_LT(set, set_type({ 1, 2, 4 }));
+	ASSERT_NE(set_type({ 1, 2 }), set);
+}
+
+TEST(BufferedOrderedSetTests, SwapTest) {
+	set_type s1({ 1, 2, 3 });
+	set_type s2({ 4, 5 });
+	std::swap(s1, s2);
+	ASSERT_EQ(set_type({ 4, 5 }), s1);
+	ASSERT_EQ(set_type({ 1, 2, 3 }), s2);
+}
\ No newline at end of file
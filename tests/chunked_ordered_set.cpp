@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/chunked_ordered_set.hpp"
+#include "detail/constants.hpp"
+#include <set>
+#include <random>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+using set_type = libra::chunked_ordered_set<int>;
+
+// Enough elements to split into several blocks
+constexpr int M = 5 * set_type::max_block_size;
+
+std::mt19937 gen{ std::random_device{}() };
+
+TEST(ChunkedOrderedSetTests, ConstructorTests) {
+	set_type s1;
+	ASSERT_TRUE(s1.empty());
+	ASSERT_EQ(s1.begin(), s1.end());
+
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+
+	// Test constructor from external container with duplicates
+	auto copy(integers);
+	integers.insert(integers.end(), copy.begin(), copy.end());
+	set_type s2(integers.begin(), integers.end());
+	ASSERT_EQ(N, s2.size());
+	ASSERT_TRUE(std::is_sorted(s2.begin(), s2.end()));
+	ASSERT_EQ(s2.end(), std::adjacent_find(s2.begin(), s2.end()));
+
+	// Test construction from a sorted range
+	std::sort(copy.begin(), copy.end());
+	set_type s3(libra::sorted_unique, copy.begin(), copy.end());
+	ASSERT_EQ(s2, s3);
+
+	// Test copy and move construction
+	s3.insert(N);
+	set_type copier(s3);
+	ASSERT_EQ(s3, copier);
+	set_type thief(std::move(copier));
+	ASSERT_TRUE(copier.empty());
+	ASSERT_EQ(s3, thief);
+
+	// Test assignment
+	s1 = { 3, 1, 2, 3 };
+	ASSERT_EQ(set_type({ 1, 2, 3 }), s1);
+}
+
+TEST(ChunkedOrderedSetTests, IteratorTests) {
+	set_type set;
+	std::vector<int> expected;
+	for (int i = 0; i < M; ++i) {
+		set.insert(i);
+		expected.push_back(i);
+		if (i % 64 == 0) {
+			ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+			ASSERT_TRUE(std::equal(expected.rbegin(), expected.rend(), set.rbegin(), set.rend()));
+		}
+	}
+	ASSERT_LT(1, set.block_count());
+	ASSERT_EQ(M, std::distance(set.cbegin(), set.cend()));
+}
+
+TEST(ChunkedOrderedSetTests, RankTests) {
+	std::vector<int> integers(M);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+	auto shuffled(integers);
+	std::shuffle(shuffled.begin(), shuffled.end(), gen);
+	set_type set;
+	for (auto integer : shuffled)
+		set.insert(integer);
+	for (int rank = 0; rank != M; ++rank) {
+		auto it = set.nth(rank);
+		ASSERT_EQ(integers[rank], *it);
+		ASSERT_EQ(rank, set.index_of(it));
+	}
+	ASSERT_EQ(set.end(), set.nth(M));
+	ASSERT_EQ(M, set.index_of(set.end()));
+}
+
+TEST(ChunkedOrderedSetTests, InsertionTests) {
+	set_type set;
+	std::set<int> expected;
+
+	// Test insertion into one region, which splits blocks repeatedly
+	for (int i = 0; i < M; ++i) {
+		int key = (i % 2 ? 1 : -1) * i;
+		auto ret = set.insert(key);
+		ASSERT_EQ(key, *ret.first);
+		ASSERT_EQ(expected.insert(key).second, ret.second);
+		auto hint = set.emplace_hint(set.begin(), key);
+		ASSERT_EQ(key, *hint);
+	}
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	// Test random insertion
+	std::vector<int> integers(M);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 7 * n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+	for (auto integer : integers) {
+		set.insert(integer);
+		expected.insert(integer);
+	}
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	// Test range insertion into a non-empty container
+	std::vector<int> more(2 * N);
+	std::generate(more.begin(), more.end(), [n = 0]() mutable { return -n++; });
+	set.insert(more.begin(), more.end());
+	expected.insert(more.begin(), more.end());
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+}
+
+TEST(ChunkedOrderedSetTests, ErasureTests) {
+	std::vector<int> integers(M);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	set_type set(libra::sorted_unique, integers.begin(), integers.end());
+	std::set<int> expected(integers.begin(), integers.end());
+
+	for (int i = 0; i < M; i += 3) {
+		ASSERT_EQ(1, set.erase(i));
+		ASSERT_EQ(0, set.erase(i));
+		expected.erase(i);
+	}
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	auto it = set.erase(set.find(4));
+	ASSERT_EQ(5, *it);
+	it = set.erase(set.lower_bound(10), set.lower_bound(20));
+	ASSERT_EQ(20, *it);
+	expected.erase(4);
+	expected.erase(expected.lower_bound(10), expected.lower_bound(20));
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	// Test range erasure spanning several blocks
+	set_type ranged(libra::sorted_unique, integers.begin(), integers.end());
+	std::set<int> ranged_expected(integers.begin(), integers.end());
+	while (!ranged.empty()) {
+		std::uniform_int_distribution<int> dist(0, static_cast<int>(ranged.size()));
+		int lo = dist(gen), hi = dist(gen);
+		if (lo > hi)
+			std::swap(lo, hi);
+		auto it = ranged.erase(ranged.nth(lo), ranged.nth(hi));
+		ranged_expected.erase(std::next(ranged_expected.begin(), lo), std::next(ranged_expected.begin(), hi));
+		ASSERT_EQ(ranged.nth(lo), it);
+		ASSERT_EQ(ranged_expected.size(), ranged.size());
+		ASSERT_TRUE(std::equal(ranged_expected.begin(), ranged_expected.end(), ranged.begin(), ranged.end()));
+	}
+	ASSERT_EQ(0, ranged.block_count());
+
+	// Test random erasure down to an empty container
+	std::vector<int> remaining(set.begin(), set.end());
+	std::shuffle(remaining.begin(), remaining.end(), gen);
+	for (auto integer : remaining) {
+		auto next = expected.upper_bound(integer);
+		auto it = set.erase(set.find(integer));
+		ASSERT_EQ(next == expected.end(), it == set.end());
+		if (next != expected.end()) {
+			ASSERT_EQ(*next, *it);
+		}
+		expected.erase(integer);
+		if (expected.size() % 64 == 0) {
+			ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+		}
+	}
+	ASSERT_TRUE(set.empty());
+	ASSERT_EQ(set.begin(), set.end());
+	ASSERT_EQ(0, set.block_count());
+}
+
+TEST(ChunkedOrderedSetTests, LookupTests) {
+	for (int size : { 0, 1, 2, 15, 16, 17, N, M }) {
+		std::vector<int> integers(size);
+		std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+		auto shuffled(integers);
+		std::shuffle(shuffled.begin(), shuffled.end(), gen);
+		set_type set;
+		for (auto integer : shuffled)
+			set.insert(integer);
+		for (int key = -1; key <= 2 * size; ++key) {
+			auto lower = std::lower_bound(integers.begin(), integers.end(), key);
+			auto upper = std::upper_bound(integers.begin(), integers.end(), key);
+			ASSERT_EQ(lower - integers.begin(), std::distance(set.begin(), set.lower_bound(key)));
+			ASSERT_EQ(upper - integers.begin(), std::distance(set.begin(), set.upper_bound(key)));
+			ASSERT_EQ(key % 2 == 0 && key >= 0 && key < 2 * size, set.contains(key));
+			ASSERT_EQ(set.contains(key) ? 1 : 0, set.count(key));
+			ASSERT_EQ(set.contains(key) ? set.lower_bound(key) : set.end(), set.find(key));
+		}
+	}
+
+	// Test heterogeneous lookup
+	libra::chunked_ordered_set<std::string, std::less<>> words({ "alpha", "gamma" });
+	words.insert("beta");
+	ASSERT_TRUE(words.contains("beta"));
+	ASSERT_EQ("gamma", *words.upper_bound("beta"));
+}
+
+TEST(ChunkedOrderedSetTests, ExtractReplaceTests) {
+	set_type set({ 1, 3 });
+	set.insert(2);
+	auto data = std::move(set).extract();
+	ASSERT_TRUE(set.empty());
+	ASSERT_EQ(std::vector<int>({ 1, 2, 3 }), data);
+
+	set.replace(std::move(data));
+	ASSERT_EQ(set_type({ 1, 2, 3 }), set);
+}
+
+TEST(ChunkedOrderedSetTests, LexicographicalTests) {
+	set_type set({ 1, 3 });
+	set.insert(2);
+	ASSERT_EQ(set_type({ 1, 2, 3 }), set);
+	ASSERT_LT(set, set_type({ 1, 2, 4 }));
+	ASSERT_NE(set_type({ 1, 2 }), set);
+}
+
+TEST(ChunkedOrderedSetTests, SwapTest) {
+	set_type s1({ 1, 2, 3 });
+	set_type s2({ 4, 5 });
+	std::swap(s1, s2);
+	ASSERT_EQ(set_type({ 4, 5 }), s1);
+	ASSERT_EQ(set_type({ 1, 2, 3 }), s2);
+}
\ No newline at end of file
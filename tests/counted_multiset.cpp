@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/counted_multiset.hpp"
+#include "detail/constants.hpp"
+#include <set>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+using multiset_type = libra::counted_multiset<int>;
+
+std::mt19937 gen{ std::random_device{}() };
+
+TEST(CountedMultisetTests, ConstructorTests) {
+	multiset_type s1;
+	ASSERT_TRUE(s1.empty());
+	ASSERT_EQ(0, s1.run_count());
+
+	std::vector<int> integers;
+	for (int i = 0; i < 10 * N; ++i)
+		integers.emplace_back(i % N);
+	std::shuffle(integers.begin(), integers.end(), gen);
+	multiset_type s2(integers.begin(), integers.end());
+	std::sort(integers.begin(), integers.end());
+	ASSERT_EQ(10 * N, s2.size());
+	ASSERT_EQ(N, s2.run_count());
+	ASSERT_TRUE(std::equal(integers.begin(), integers.end(), s2.begin(), s2.end()));
+
+	multiset_type s3(libra::sorted_equivalent, integers.begin(), integers.end());
+	ASSERT_EQ(s2, s3);
+
+	multiset_type s4(s3);
+	ASSERT_EQ(s3, s4);
+	multiset_type s5(std::move(s4));
+	ASSERT_EQ(s3, s5);
+	ASSERT_TRUE(s4.empty());
+
+	multiset_type s6({ 3, 1, 3, 2, 3 });
+	ASSERT_EQ(5, s6.size());
+	ASSERT_EQ(3, s6.run_count());
+	ASSERT_EQ(3, s6.count(3));
+}
+
+TEST(CountedMultisetTests, InsertionTests) {
+	std::multiset<int> expected;
+	multiset_type set;
+	std::uniform_int_distribution<int> dist(0, N);
+	for (int i = 0; i < 20 * N; ++i) {
+		int value = dist(gen);
+		auto it = set.insert(value);
+		ASSERT_EQ(value, *it);
+		ASSERT_EQ(set.upper_bound(value), std::next(it));
+		expected.insert(value);
+	}
+	ASSERT_EQ(expected.size(), set.size());
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+	ASSERT_TRUE(std::equal(expected.rbegin(), expected.rend(), set.rbegin(), set.rend()));
+
+	auto it = set.insert_n(-1, 1000000);
+	ASSERT_EQ(set.begin(), it);
+	ASSERT_EQ(1000000, set.count(-1));
+	ASSERT_EQ(expected.size() + 1000000, set.size());
+	ASSERT_EQ(set.lower_bound(-2), set.insert_n(-2, 0));
+
+	// Range insertion merges into the existing runs
+	std::vector<int> more(5 * N);
+	std::generate(more.begin(), more.end(), [n = 0]() mutable { return n++ % (2 * N); });
+	set.insert(more.begin(), more.end());
+	expected.insert(more.begin(), more.end());
+	ASSERT_EQ(expected.size() + 1000000, set.size());
+	for (int i = 0; i <= 2 * N; ++i)
+		ASSERT_EQ(expected.count(i), set.count(i));
+}
+
+TEST(CountedMultisetTests, ErasureTests) {
+	std::multiset<int> expected;
+	multiset_type set;
+	for (int i = 0; i < 10 * N; ++i) {
+		expected.insert(i % N);
+		set.insert(i % N);
+	}
+
+	// One instance at a time
+	for (int i = 0; i < N; i += 2) {
+		auto it = set.erase(set.find(i));
+		expected.erase(expected.find(i));
+		ASSERT_EQ(i, *it);
+		ASSERT_EQ(expected.count(i), set.count(i));
+	}
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	// Every instance of a key
+	for (int i = 0; i < N; i += 3) {
+		ASSERT_EQ(expected.erase(i), set.erase(i));
+		ASSERT_FALSE(set.contains(i));
+	}
+	ASSERT_EQ(0, set.erase(-1));
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	// Ranges starting and ending inside runs
+	while (!set.empty()) {
+		std::size_t first = gen() % set.size();
+		std::size_t last = first + gen() % (set.size() - first + 1);
+		auto it = set.erase(set.nth(first), set.nth(last));
+		expected.erase(std::next(expected.begin(), first), std::next(expected.begin(), last));
+		ASSERT_EQ(first, set.index_of(it));
+		ASSERT_EQ(expected.size(), set.size());
+		ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+	}
+	ASSERT_EQ(0, set.run_count());
+	ASSERT_EQ(set.begin(), set.end());
+}
+
+TEST(CountedMultisetTests, RankTests) {
+	std::vector<int> integers;
+	for (int i = 0; i < N; ++i)
+		integers.insert(integers.end(), i % 7 + 1, 2 * i);
+	multiset_type set(integers.begin(), integers.end());
+	for (std::size_t rank = 0; rank != integers.size(); ++rank) {
+		auto it = set.nth(rank);
+		ASSERT_EQ(integers[rank], *it);
+		ASSERT_EQ(rank, set.index_of(it));
+	}
+	ASSERT_EQ(set.end(), set.nth(set.size()));
+	ASSERT_EQ(set.size(), set.index_of(set.end()));
+}
+
+TEST(CountedMultisetTests, LookupTests) {
+	std::vector<int> integers;
+	for (int i = 0; i < N; ++i)
+		integers.insert(integers.end(), i % 5 + 1, 3 * i);
+	multiset_type set(integers.begin(), integers.end());
+	for (int key = -1; key <= 3 * N; ++key) {
+		auto range = set.equal_range(key);
+		auto expected = std::equal_range(integers.begin(), integers.end(), key);
+		ASSERT_EQ(expected.first - integers.begin(), set.index_of(range.first));
+		ASSERT_EQ(expected.second - integers.begin(), set.index_of(range.second));
+		ASSERT_EQ(expected.second - expected.first, set.count(key));
+		ASSERT_EQ(key % 3 == 0 && key >= 0 && key < 3 * N, set.contains(key));
+		ASSERT_EQ(set.index_of(range.first), set.index_of(set.lower_bound(key)));
+		ASSERT_EQ(set.index_of(range.second), set.index_of(set.upper_bound(key)));
+	}
+
+	libra::counted_multiset<std::string, std::less<>> words;
+	words.insert_n("apple", 3);
+	words.emplace("pear");
+	ASSERT_EQ(3, words.count(std::string_view("apple")));
+	ASSERT_TRUE(words.contains("pear"));
+	ASSERT_EQ(words.end(), words.find("plum"));
+}
+
+TEST(CountedMultisetTests, LexicographicalTests) {
+	ASSERT_EQ(multiset_type({ 1, 1, 2 }), multiset_type({ 2, 1, 1 }));
+	ASSERT_NE(multiset_type({ 1, 1, 2 }), multiset_type({ 1, 2 }));
+	ASSERT_LT(multiset_type({ 1, 1, 2 }), multiset_type({ 1, 2 }));
+	ASSERT_GE(multiset_type({ 1, 1, 2 }), multiset_type({ 1, 1 }));
+}
+
+TEST(CountedMultisetTests, SwapTests) {
+	multiset_type s1({ 1, 1, 2 });
+	multiset_type s2({ 3 });
+	std::swap(s1, s2);
+	ASSERT_EQ(multiset_type({ 3 }), s1);
+	ASSERT_EQ(multiset_type({ 1, 1, 2 }), s2);
+}
\ No newline at end of file
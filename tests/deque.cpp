@@ -382,3 +382,45 @@ TEST(DequeTests, SwapTests) {
 	ASSERT_EQ(d4, z);
 
 }
+
+
+TEST(DequeTests, StatsTests) {
+	libra::deque<int, std::allocator<int>, libra::counting_stats> deque;
+	for (int i = 0; i < 8; ++i)
+		deque.push_back(i);
+	// Capacity doubles from 1 to 8, moving 0 + 1 + 2 + 4 elements
+	ASSERT_EQ(4, deque.stats().allocations);
+	ASSERT_EQ(15 * sizeof(int), deque.stats().bytes_allocated);
+	ASSERT_EQ(7, deque.stats().moves);
+	ASSERT_EQ(0, deque.stats().comparisons);
+
+	deque.stats().reset();
+	deque.insert(deque.begin() + 6, 42);
+	ASSERT_EQ(1, deque.stats().allocations);
+	ASSERT_EQ(1, deque.stats().rotations);
+	ASSERT_EQ(3, deque.stats().rotate_distance);
+	ASSERT_EQ(8 + 3, deque.stats().moves);
+
+	deque.stats().reset();
+	deque.erase(deque.begin() + 2);
+	ASSERT_EQ(1, deque.stats().rotations);
+	ASSERT_EQ(3, deque.stats().rotate_distance);
+	ASSERT_EQ(0, deque.stats().allocations);
+	ASSERT_EQ(libra::deque<int>({ 0, 1, 3, 4, 5, 42, 6, 7 }), libra::deque<int>(deque.begin(), deque.end()));
+}
+
+TEST(DequeTests, MemoryUsageTests) {
+	libra::deque<std::vector<int>> deque;
+	ASSERT_EQ(0, deque.allocated_bytes());
+	for (int i = 0; i < 5; ++i)
+		deque.emplace_front(std::vector<int>(10));
+	ASSERT_EQ(deque.capacity() * sizeof(std::vector<int>), deque.allocated_bytes());
+	ASSERT_EQ(3 * sizeof(std::vector<int>), deque.wasted_capacity());
+
+	auto usage = deque.memory_usage();
+	ASSERT_EQ(5 * sizeof(std::vector<int>), usage.used_bytes);
+	ASSERT_EQ(50 * sizeof(int), usage.element_bytes);
+
+	deque.shrink_to_fit();
+	ASSERT_EQ(0, deque.wasted_capacity());
+}
\ No newline at end of file
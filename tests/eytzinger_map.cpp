@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/eytzinger_map.hpp"
+#include "detail/constants.hpp"
+#include <random>
+#include <vector>
+#include <algorithm>
+
+using map_type = libra::eytzinger_map<int, int>;
+using pair_type = std::pair<int, int>;
+
+std::mt19937 gen{ std::random_device{}() };
+
+TEST(EytzingerMapTests, ConstructorTests) {
+	std::vector<pair_type> pairs;
+	for (int i = 0; i < N; ++i)
+		pairs.emplace_back(i, i);
+	std::shuffle(pairs.begin(), pairs.end(), gen);
+	map_type map(pairs.begin(), pairs.end());
+	ASSERT_EQ(N, map.size());
+	int expected = 0;
+	for (auto [key, value] : map) {
+		ASSERT_EQ(expected++, key);
+		ASSERT_EQ(key, value);
+	}
+}
+
+TEST(EytzingerMapTests, ElementAccessTests) {
+	map_type map({ {3, 30}, {1, 10}, {2, 20} });
+	ASSERT_EQ(20, map.at(2));
+	map.at(2) = -20;
+	ASSERT_EQ(-20, map.find(2)->second);
+	for (auto& pair : map)
+		pair.second = pair.first;
+	ASSERT_EQ(map_type({ {1, 1}, {2, 2}, {3, 3} }), map);
+	ASSERT_THROW(map.at(4), std::out_of_range);
+}
+
+TEST(EytzingerMapTests, LookupTests) {
+	std::vector<pair_type> pairs;
+	for (int i = 1; i <= N; ++i)
+		pairs.emplace_back(i, -i);
+	map_type map(libra::sorted_unique, pairs.begin(), pairs.end());
+	for (int i = 1; i <= N; ++i) {
+		ASSERT_FALSE(map.contains(-i));
+		ASSERT_EQ(-i, map.find(i)->second);
+		ASSERT_EQ(i - 1, map.index_of(map.find(i)));
+		ASSERT_EQ(i, map.nth(i - 1)->first);
+	}
+}
\ No newline at end of file
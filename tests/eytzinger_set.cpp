@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/eytzinger_set.hpp"
+#include "../include/libra/container/ordered_set.hpp"
+#include "detail/constants.hpp"
+#include <random>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+using set_type = libra::eytzinger_set<int>;
+
+std::mt19937 gen{ std::random_device{}() };
+
+TEST(EytzingerSetTests, ConstructorTests) {
+	set_type s1;
+	ASSERT_TRUE(s1.empty());
+	ASSERT_EQ(s1.begin(), s1.end());
+
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+
+	// Test constructor from external container with duplicates
+	auto copy(integers);
+	integers.insert(integers.end(), copy.begin(), copy.end());
+	set_type s2(integers.begin(), integers.end());
+	ASSERT_EQ(N, s2.size());
+	ASSERT_TRUE(std::is_sorted(s2.begin(), s2.end()));
+	ASSERT_EQ(s2.end(), std::adjacent_find(s2.begin(), s2.end()));
+
+	// Test construction from an existing ordered set
+	libra::ordered_set<int> ordered(copy.begin(), copy.end());
+	set_type s3(libra::sorted_unique, ordered.begin(), ordered.end());
+	ASSERT_EQ(s2, s3);
+	ASSERT_TRUE(std::equal(ordered.begin(), ordered.end(), s3.begin(), s3.end()));
+
+	// Test copy and move construction
+	set_type copier(s3);
+	ASSERT_EQ(s3, copier);
+	set_type thief(std::move(copier));
+	ASSERT_TRUE(copier.empty());
+	ASSERT_EQ(s3, thief);
+
+	// Test assignment
+	s1 = { 3, 1, 2, 3 };
+	ASSERT_EQ(set_type({ 1, 2, 3 }), s1);
+}
+
+TEST(EytzingerSetTests, IteratorTests) {
+	// Every tree shape from empty to several full levels
+	for (int size = 0; size <= 70; ++size) {
+		std::vector<int> integers(size);
+		std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+		set_type set(libra::sorted_unique, integers.begin(), integers.end());
+		ASSERT_TRUE(std::equal(integers.begin(), integers.end(), set.begin(), set.end()));
+		ASSERT_TRUE(std::equal(integers.rbegin(), integers.rend(), set.rbegin(), set.rend()));
+		ASSERT_EQ(size, std::distance(set.cbegin(), set.cend()));
+	}
+}
+
+TEST(EytzingerSetTests, RankTests) {
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+	set_type set(libra::sorted_unique, integers.begin(), integers.end());
+	for (int rank = 0; rank != N; ++rank) {
+		auto it = set.nth(rank);
+		ASSERT_EQ(integers[rank], *it);
+		ASSERT_EQ(rank, set.index_of(it));
+	}
+	ASSERT_EQ(set.end(), set.nth(N));
+	ASSERT_EQ(N, set.index_of(set.end()));
+}
+
+TEST(EytzingerSetTests, LookupTests) {
+	for (int size : { 0, 1, 2, 15, 16, 17, N }) {
+		std::vector<int> integers(size);
+		std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+		set_type set(libra::sorted_unique, integers.begin(), integers.end());
+		for (int key = -1; key <= 2 * size; ++key) {
+			auto lower = std::lower_bound(integers.begin(), integers.end(), key);
+			auto upper = std::upper_bound(integers.begin(), integers.end(), key);
+			ASSERT_EQ(lower - integers.begin(), set.index_of(set.lower_bound(key)));
+			ASSERT_EQ(upper - integers.begin(), set.index_of(set.upper_bound(key)));
+			ASSERT_EQ(key % 2 == 0 && key >= 0 && key < 2 * size, set.contains(key));
+			ASSERT_EQ(set.contains(key) ? 1 : 0, set.count(key));
+			ASSERT_EQ(set.contains(key) ? set.lower_bound(key) : set.end(), set.find(key));
+		}
+	}
+
+	// Test heterogeneous lookup
+	libra::eytzinger_set<std::string, std::less<>> words({ "alpha", "beta", "gamma" });
+	ASSERT_TRUE(words.contains("beta"));
+	ASSERT_EQ("gamma", *words.upper_bound("beta"));
+}
+
+TEST(EytzingerSetTests, LexicographicalTests) {
+	ASSERT_EQ(set_type({ 1, 2, 3 }), set_type({ 3, 2, 1 }));
+	ASSERT_LT(set_type({ 1, 2, 3 }), set_type({ 1, 2, 4 }));
+	ASSERT_NE(set_type({ 1, 2 }), set_type({ 1, 2, 3 }));
+}
+
+TEST(EytzingerSetTests, SwapTest) {
+	set_type s1({ 1, 2, 3 });
+	set_type s2({ 4, 5 });
+	std::swap(s1, s2);
+	ASSERT_EQ(set_type({ 4, 5 }), s1);
+	ASSERT_EQ(set_type({ 1, 2, 3 }), s2);
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/gap_ordered_set.hpp"
+#include "detail/constants.hpp"
+#include <set>
+#include <random>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+using set_type = libra::gap_ordered_set<int>;
+
+std::mt19937 gen{ std::random_device{}() };
+
+TEST(GapOrderedSetTests, ConstructorTests) {
+	set_type s1;
+	ASSERT_TRUE(s1.empty());
+	ASSERT_EQ(s1.begin(), s1.end());
+
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+
+	// Test constructor from external container with duplicates
+	auto copy(integers);
+	integers.insert(integers.end(), copy.begin(), copy.end());
+	set_type s2(integers.begin(), integers.end());
+	ASSERT_EQ(N, s2.size());
+	ASSERT_TRUE(std::is_sorted(s2.begin(), s2.end()));
+	ASSERT_EQ(s2.end(), std::adjacent_find(s2.begin(), s2.end()));
+
+	// Test construction from a sorted range
+	std::sort(copy.begin(), copy.end());
+	set_type s3(libra::sorted_unique, copy.begin(), copy.end());
+	ASSERT_EQ(s2, s3);
+
+	// Test copy and move construction
+	s3.insert(N);
+	set_type copier(s3);
+	ASSERT_EQ(s3, copier);
+	set_type thief(std::move(copier));
+	ASSERT_TRUE(copier.empty());
+	ASSERT_EQ(s3, thief);
+
+	// Test assignment
+	s1 = { 3, 1, 2, 3 };
+	ASSERT_EQ(set_type({ 1, 2, 3 }), s1);
+}
+
+TEST(GapOrderedSetTests, IteratorTests) {
+	set_type set({ 10, 20, 40, 50 });
+	set.insert(30);
+	ASSERT_EQ(2, set.gap_position() - 1);
+
+	// Test random access across the gap
+	std::vector<int> expected({ 10, 20, 30, 40, 50 });
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+	ASSERT_TRUE(std::equal(expected.rbegin(), expected.rend(), set.rbegin(), set.rend()));
+	set_type::const_iterator cit = set.begin();
+	ASSERT_EQ(40, *(cit + 3));
+	ASSERT_EQ(50, cit[4]);
+	ASSERT_EQ(5, set.end() - cit);
+	ASSERT_EQ(30, *(set.end() - 3));
+}
+
+TEST(GapOrderedSetTests, InsertionTests) {
+	set_type set;
+	std::set<int> expected;
+
+	// Test insertion around a moving frontier, with and without hints
+	std::uniform_int_distribution<int> jitter(-8, 8);
+	auto hint = set.begin();
+	for (int frontier = 0; frontier < 20 * N; frontier += 3) {
+		int key = frontier + jitter(gen);
+		auto ret = set.insert(key);
+		ASSERT_EQ(key, *ret.first);
+		ASSERT_EQ(expected.insert(key).second, ret.second);
+		if (ret.second) {
+			ASSERT_EQ(ret.first - set.begin() + 1, set.gap_position());
+		}
+		hint = set.emplace_hint(hint, key + 1);
+		ASSERT_EQ(key + 1, *hint);
+		expected.insert(key + 1);
+	}
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	// Test random insertion
+	std::vector<int> integers(4 * N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 7 * n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+	for (auto integer : integers) {
+		set.insert(integer);
+		expected.insert(integer);
+	}
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	// Test range insertion into a non-empty container
+	std::vector<int> more(2 * N);
+	std::generate(more.begin(), more.end(), [n = 0]() mutable { return -n++; });
+	set.insert(more.begin(), more.end());
+	expected.insert(more.begin(), more.end());
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+}
+
+TEST(GapOrderedSetTests, ErasureTests) {
+	std::vector<int> integers(2 * N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	set_type set(libra::sorted_unique, integers.begin(), integers.end());
+	std::set<int> expected(integers.begin(), integers.end());
+
+	for (int i = 0; i < 2 * N; i += 3) {
+		ASSERT_EQ(1, set.erase(i));
+		ASSERT_EQ(0, set.erase(i));
+		expected.erase(i);
+	}
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	auto it = set.erase(set.find(4));
+	ASSERT_EQ(5, *it);
+	it = set.erase(set.lower_bound(10), set.lower_bound(20));
+	ASSERT_EQ(20, *it);
+	expected.erase(4);
+	expected.erase(expected.lower_bound(10), expected.lower_bound(20));
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), set.begin(), set.end()));
+
+	while (!set.empty())
+		ASSERT_EQ(set.begin(), set.erase(set.begin()));
+}
+
+TEST(GapOrderedSetTests, LookupTests) {
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+	for (auto gap : { 0, 1, N / 2, N }) {
+		set_type set(libra::sorted_unique, integers.begin(), integers.end());
+		set.erase(2 * N);
+		set.reserve(2 * N);
+		set.insert(gap == N ? 2 * N : 2 * gap - 1);
+		set.erase(gap == N ? 2 * N : 2 * gap - 1);
+		ASSERT_EQ(gap, set.gap_position());
+		for (int key = -1; key <= 2 * N; ++key) {
+			auto lower = std::lower_bound(integers.begin(), integers.end(), key);
+			auto upper = std::upper_bound(integers.begin(), integers.end(), key);
+			ASSERT_EQ(lower - integers.begin(), set.lower_bound(key) - set.begin());
+			ASSERT_EQ(upper - integers.begin(), set.upper_bound(key) - set.begin());
+			ASSERT_EQ(key % 2 == 0 && key >= 0 && key < 2 * N, set.contains(key));
+			ASSERT_EQ(set.contains(key) ? 1 : 0, set.count(key));
+			ASSERT_EQ(set.contains(key) ? set.lower_bound(key) : set.end(), set.find(key));
+		}
+	}
+
+	// Test heterogeneous lookup
+	libra::gap_ordered_set<std::string, std::less<>> words({ "alpha", "gamma" });
+	words.insert("beta");
+	ASSERT_TRUE(words.contains("beta"));
+	ASSERT_EQ("gamma", *words.upper_bound("beta"));
+}
+
+TEST(GapOrderedSetTests, ExtractReplaceTests) {
+	set_type set({ 1, 3 });
+	set.insert(2);
+	auto data = std::move(set).extract();
+	ASSERT_TRUE(set.empty());
+	ASSERT_EQ(std::vector<int>({ 1, 2, 3 }), data);
+
+	set.replace(std::move(data));
+	ASSERT_EQ(set_type({ 1, 2, 3 }), set);
+}
+
+TEST(GapOrderedSetTests, LexicographicalTests) {
+	set_type set({ 1, 3 });
+	set.insert(2);
+	ASSERT_EQ(set_type({ 1, 2, 3 }), set);
+	ASSERT_LT(set, set_type({ 1, 2, 4 }));
+	ASSERT_NE(set_type({ 1, 2 }), set);
+}
+
+TEST(GapOrderedSetTests, SwapTest) {
+	set_type s1({ 1, 2, 3 });
+	set_type s2({ 4, 5 });
+	std::swap(s1, s2);
+	ASSERT_EQ(set_type({ 4, 5 }), s1);
+	ASSERT_EQ(set_type({ 1, 2, 3 }), s2);
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
+#include <array>
+#include <ctime>
 #include <vector>
 #include <cstdlib>
+#include <functional>
 #include <algorithm>
 #include "detail/constants.hpp"
 #include "../include/libra/algorithm/heap.hpp"
@@ -38,9 +41,69 @@ TEST(HeapTests, PopHeapTests) {
 	libra::make_heap(nums.begin(), nums.end());
 	ASSERT_TRUE(std::is_heap(nums.begin(), nums.end()));
 	for (int i = 0; i != N; ++i) {
+		int largest = *std::max_element(nums.begin(), nums.end());
 		libra::pop_heap(nums.begin(), nums.end());
+		ASSERT_EQ(largest, nums.back());
 		nums.pop_back();
 		ASSERT_TRUE(std::is_heap(nums.begin(), nums.end()));
 		std::generate(nums.begin(), nums.end(), []() { return std::rand() % 100 + 1; });
+		libra::make_heap(nums.begin(), nums.end());
+	}
+}
+
+TEST(HeapTests, SortHeapTests) {
+	for (int size = 0; size != N; ++size) {
+		std::vector<int> nums;
+		std::generate_n(std::back_inserter(nums), size, []() { return std::rand() % 100 + 1; });
+		libra::make_heap(nums.begin(), nums.end(), std::greater<>{});
+		libra::sort_heap(nums.begin(), nums.end(), std::greater<>{});
+		ASSERT_TRUE(std::is_sorted(nums.begin(), nums.end(), std::greater<>{}));
+	}
+}
+
+TEST(HeapTests, IsHeapTests) {
+	for (int i = 0; i != N; ++i) {
+		std::vector<int> nums;
+		std::generate_n(std::back_inserter(nums), i, []() { return std::rand() % 10; });
+		ASSERT_EQ(std::is_heap_until(nums.begin(), nums.end()), libra::is_heap_until(nums.begin(), nums.end()));
+		ASSERT_EQ(std::is_heap(nums.begin(), nums.end()), libra::is_heap(nums.begin(), nums.end()));
+		libra::make_heap(nums.begin(), nums.end());
+		ASSERT_TRUE(libra::is_heap(nums.begin(), nums.end()));
 	}
+}
+
+TEST(HeapTests, UpdateHeapTests) {
+	std::vector<int> nums;
+	std::generate_n(std::back_inserter(nums), 10 * N, []() { return std::rand() % 1000; });
+	libra::make_heap(nums.begin(), nums.end());
+	for (int i = 0; i != 10 * N; ++i) {
+		auto pos = nums.begin() + std::rand() % nums.size();
+		*pos += std::rand() % 2 ? 500 : -500;
+		libra::update_heap(nums.begin(), nums.end(), pos);
+		ASSERT_TRUE(std::is_heap(nums.begin(), nums.end()));
+	}
+}
+
+constexpr std::array<int, 8> heap_sorted(std::array<int, 8> nums) {
+	libra::make_heap(nums.begin(), nums.end());
+	nums[5] = 10;
+	libra::update_heap(nums.begin(), nums.end(), nums.begin() + 5);
+	libra::push_heap(nums.begin(), nums.end());
+	libra::sort_heap(nums.begin(), nums.end());
+	return nums;
+}
+
+constexpr bool ascending(const std::array<int, 8>& nums) {
+	for (std::size_t i = 1; i != nums.size(); ++i) {
+		if (nums[i] < nums[i - 1])
+			return false;
+	}
+	return true;
+}
+
+TEST(HeapTests, ConstexprTests) {
+	constexpr auto nums = heap_sorted({ 5, 3, 8, 1, 9, 2, 7, 4 });
+	static_assert(ascending(nums) && nums.back() == 10);
+	static_assert(libra::is_heap(nums.rbegin(), nums.rend()));
+	static_assert(libra::is_heap_until(nums.begin(), nums.end()) == nums.begin() + 1);
 }
\ No newline at end of file
@@ -2,7 +2,11 @@
 #include "../include/libra/container/ordered_map.hpp"
 #include "detail/constants.hpp"
 #include <random>
+#include <string>
 #include <vector>
+#include <string_view>
+#include <utility>
+#include <iterator>
 #include <algorithm>
 
 using map_type = libra::ordered_map<int, int>;
@@ -330,6 +334,70 @@ TEST(OrderedMapTests, InsertOrAssignTests) {
 	}
 }
 
+TEST(OrderedMapTests, InsertCheckTests) {
+	std::vector<int> integers(4 * N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+	map_type map;
+	for (auto integer : integers) {
+		map_type::insert_commit_data data;
+		auto ret = map.insert_check(integer, data);
+		ASSERT_TRUE(ret.second);
+		auto it = map.insert_commit(data, integer, -integer);
+		ASSERT_EQ(integer, it->first);
+		ASSERT_EQ(map.lower_bound(integer), it);
+		ret = map.insert_check(map.cbegin(), integer, data);
+		ASSERT_FALSE(ret.second);
+		ASSERT_EQ(it, ret.first);
+	}
+	ASSERT_EQ(4 * N, map.size());
+	ASSERT_TRUE(std::is_sorted(map.begin(), map.end(), map.value_comp()));
+
+	// Duplicate keys construct no mapped value
+	struct counted {
+		int* count;
+		counted(int* count) : count(count) { ++*count; }
+	};
+	int constructed = 0;
+	libra::ordered_map<int, counted> counts;
+	for (int i = 0; i < N; ++i)
+		counts.try_emplace(i % 10, &constructed);
+	ASSERT_EQ(10, constructed);
+	ASSERT_EQ(10, counts.size());
+}
+
+TEST(OrderedMapTests, HeterogeneousKeyTests) {
+	libra::ordered_map<std::string, int, std::less<>> map;
+	std::vector<std::string> words;
+	for (int i = 0; i < N; ++i)
+		words.emplace_back(std::to_string(i));
+	for (const auto& word : words) {
+		std::string_view key = word;
+		map[key] += 1;
+		ASSERT_TRUE(map.try_emplace(key, 5).second == false);
+		ASSERT_EQ(1, map.at(key));
+		map.insert_or_assign(key, 2);
+		ASSERT_EQ(2, std::as_const(map).at(key));
+	}
+	ASSERT_EQ(N, map.size());
+	ASSERT_THROW(map.at(std::string_view("-1")), std::out_of_range);
+
+	auto it = map.try_emplace(map.cend(), std::string_view("zz"), 3);
+	ASSERT_EQ("zz", it->first);
+	it = map.insert_or_assign(map.cbegin(), std::string_view("zz"), 4);
+	ASSERT_EQ(4, it->second);
+	ASSERT_EQ(1, map.erase(std::string_view("zz")));
+	ASSERT_EQ(0, map.erase(std::string_view("zz")));
+	ASSERT_EQ(N, map.size());
+
+	// Iterators still select the positional overloads
+	map.erase(map.begin());
+	ASSERT_EQ(N - 1, map.size());
+	for (const auto& word : words)
+		map.erase(std::string_view(word));
+	ASSERT_TRUE(map.empty());
+}
+
 TEST(OrderedMapTests, ErasureTests) {
 	map_type map;
 	std::vector<int> integers;
@@ -369,6 +437,44 @@ TEST(OrderedMapTests, LookupTests) {
 	}
 }
 
+TEST(OrderedMapTests, BatchLookupTests) {
+	map_type map;
+	for (int i = 0; i < 2 * N; i += 2)
+		map.emplace(i, i);
+	std::vector<int> keys;
+	for (int i = -1; i <= 2 * N; ++i)
+		keys.emplace_back(i);
+	// Sorted and shuffled batches take different paths
+	for (int pass = 0; pass != 2; ++pass) {
+		std::vector<map_type::iterator> found, lower;
+		std::vector<map_type::const_iterator> upper;
+		map.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+		map.lower_bound_many(keys.begin(), keys.end(), std::back_inserter(lower));
+		std::as_const(map).upper_bound_many(keys.begin(), keys.end(), std::back_inserter(upper));
+		ASSERT_EQ(keys.size(), found.size());
+		for (std::size_t i = 0; i != keys.size(); ++i) {
+			ASSERT_EQ(map.find(keys[i]), found[i]);
+			ASSERT_EQ(map.lower_bound(keys[i]), lower[i]);
+			ASSERT_EQ(map.upper_bound(keys[i]), upper[i]);
+		}
+		std::shuffle(keys.begin(), keys.end(), gen);
+	}
+}
+
+TEST(OrderedMapTests, FrozenLookupTests) {
+	map_type map;
+	for (int i = 0; i < 40 * N; i += 2)
+		map.emplace(i, -i);
+	map.freeze();
+	for (int i = -1; i <= 40 * N; ++i) {
+		ASSERT_EQ(i % 2 == 0 && i >= 0 && i < 40 * N, map.contains(i));
+		ASSERT_EQ((i + 1) / 2, map.lower_bound(i) - map.begin());
+	}
+	map[1] = 1;
+	ASSERT_EQ(1, map.at(1));
+	ASSERT_EQ(-2, map.at(2));
+}
+
 TEST(OrderedMapTests, LexicographicalTests) {
 	ASSERT_EQ(map_type({ {1, 1}, {2, 2}, {3, 3} }), map_type({ {1, 1}, {2, 2}, {3, 3} }));
 	ASSERT_LE(map_type({ {1, 1}, {2, 2}, {3, 3} }), map_type({ {2, 3}, {3, 8}, {4, 3} }));
@@ -380,4 +486,21 @@ TEST(OrderedMapTests, SwapTest) {
 	m1.swap(m2);
 	ASSERT_EQ(m1, map_type({ {2, 3}, {3, 8}, {4, 3} }));
 	ASSERT_EQ(m2, map_type({ {1, 1}, {2, 2}, {3, 3} }));
+}
+
+TEST(OrderedMapTests, MemoryUsageTests) {
+	libra::ordered_map<int, std::string> map;
+	map.reserve(N);
+	std::size_t expected = 0;
+	for (int i = 0; i < N; ++i) {
+		map[i] = std::string(i % 64, 'x');
+		expected += libra::heap_bytes<std::string>::bytes(map[i]);
+	}
+	auto usage = map.memory_usage();
+	ASSERT_EQ(map.allocated_bytes(), usage.allocated_bytes);
+	ASSERT_EQ(N * sizeof(std::pair<int, std::string>), usage.used_bytes);
+	ASSERT_EQ(map.wasted_capacity(), usage.wasted_bytes());
+	ASSERT_EQ(expected, usage.element_bytes);
+	ASSERT_LT(0, usage.element_bytes);
+	ASSERT_EQ(usage.allocated_bytes + usage.element_bytes, usage.total_bytes());
 }
\ No newline at end of file
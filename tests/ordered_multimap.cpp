@@ -215,6 +215,40 @@ TEST(OrderedMultimapTests, InsertionTests) {
 	}
 }
 
+TEST(OrderedMultimapTests, RangeInsertionTests) {
+	// Setup
+	std::vector<pair_type> pairs;
+	for (int i = 0; i < N; ++i) {
+		for (int j = 0; j < N; ++j) {
+			pairs.emplace_back(std::make_pair(i, j));
+		}
+	}
+	std::vector<pair_type> first_half(pairs.begin(), pairs.begin() + pairs.size() / 2);
+	std::vector<pair_type> second_half(pairs.begin() + pairs.size() / 2, pairs.end());
+	for (auto& pair : first_half)
+		pair.first = N - 1 - pair.first;
+	for (auto& pair : second_half)
+		pair.first = N - 1 - pair.first;
+
+	// Test that bulk insertion keeps equivalent elements in insertion order
+	multimap_type multimap(second_half.begin(), second_half.end());
+	multimap.insert(first_half.begin(), first_half.end());
+	ASSERT_EQ(pairs.size(), multimap.size());
+	ASSERT_TRUE(std::is_sorted(multimap.begin(), multimap.end(), multimap.value_comp()));
+	for (int i = 0; i < N; ++i) {
+		auto range = multimap.equal_range(i);
+		ASSERT_EQ(N, range.second - range.first);
+		ASSERT_TRUE(std::is_sorted(range.first, range.second, secondary_compare()));
+	}
+
+	// Test that bulk inserted duplicates land after the existing ones
+	multimap.insert({ { 0, -1 }, { 0, -2 } });
+	auto range = multimap.equal_range(0);
+	ASSERT_EQ(N + 2, range.second - range.first);
+	ASSERT_EQ(-1, std::prev(range.second, 2)->second);
+	ASSERT_EQ(-2, std::prev(range.second)->second);
+}
+
 TEST(OrderedMultimapTests, ErasureTests){
 	// setup
 	std::vector<pair_type> pairs;
@@ -205,6 +205,32 @@ TEST(OrderedMultisetTests, InsertionTests) {
 		ASSERT_EQ(N, multiset.count(std::pair(i, i)));
 }
 
+TEST(OrderedMultisetTests, SortedInputTests) {
+	std::vector<pair_type> pairs;
+	for (int i = 0; i < N; ++i) {
+		pairs.emplace_back(std::make_pair(i, 0));
+		pairs.emplace_back(std::make_pair(i, 1));
+	}
+
+	// Test construction from a sorted range
+	multiset_type ms1(libra::sorted_equivalent, pairs.begin(), pairs.end());
+	ASSERT_EQ(2 * N, ms1.size());
+	ASSERT_TRUE(std::equal(ms1.begin(), ms1.end(), pairs.begin(), pairs.end()));
+
+	// Test that sorted insertion places equivalent elements after the existing ones
+	std::vector<pair_type> more;
+	for (int i = 0; i < N; ++i)
+		more.emplace_back(std::make_pair(i, 2));
+	ms1.insert(libra::sorted_equivalent, more.begin(), more.end());
+	ASSERT_EQ(3 * N, ms1.size());
+	ASSERT_TRUE(std::is_sorted(ms1.begin(), ms1.end(), ms1.value_comp()));
+	for (int i = 0; i < N; ++i) {
+		auto range = ms1.equal_range(std::make_pair(i, 0));
+		ASSERT_EQ(3, range.second - range.first);
+		ASSERT_TRUE(std::is_sorted(range.first, range.second, secondary_compare()));
+	}
+}
+
 TEST(OrderedMultisetTests, ErasureTests) {
 	std::vector<pair_type> pairs;
 	for (int i = 1; i <= N; ++i) {
@@ -254,6 +280,33 @@ TEST(OrderedMultisetTests, LookupTests) {
 	}
 }
 
+TEST(OrderedMultisetTests, InterpolationSearchTests) {
+	libra::ordered_multiset<unsigned, std::less<unsigned>, std::allocator<unsigned>, libra::interpolation_search_policy> set;
+	std::vector<unsigned> keys;
+	for (unsigned i = 0; i < 20 * N; ++i)
+		keys.insert(keys.end(), i % 5 + 1, 3 * i);
+	set.insert(keys.begin(), keys.end());
+	for (unsigned key = 0; key <= 60 * N; ++key) {
+		auto range = set.equal_range(key);
+		auto expected = std::equal_range(keys.begin(), keys.end(), key);
+		ASSERT_EQ(expected.first - keys.begin(), range.first - set.begin());
+		ASSERT_EQ(expected.second - keys.begin(), range.second - set.begin());
+	}
+}
+
+TEST(OrderedMultisetTests, HintedLookupTests) {
+	libra::ordered_multiset<int> set;
+	for (int i = 0; i < 20 * N; ++i)
+		set.insert(set.end(), i / 3);
+	auto hint = set.cbegin();
+	for (int key = -1; key <= 7 * N; ++key) {
+		auto range = set.equal_range(hint, key);
+		ASSERT_EQ(set.equal_range(key), range);
+		ASSERT_EQ(set.upper_bound(key), set.upper_bound(set.cend(), key));
+		hint = range.second;
+	}
+}
+
 TEST(OrderedMultisetTests, LexicographicalTests) {
 	ASSERT_EQ(multiset_type({ {0, 0}, {1, 1}, {2, 2} }), multiset_type({ {0, 0}, {1, 1}, {2, 2} }));
 	ASSERT_LE(multiset_type({ {0, 0}, {1, 1}, {2, 2} }), multiset_type({ {1, 2}, {2, 5} }));
@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "../include/libra/container/ordered_set.hpp"
 #include <random>
+#include <cstdint>
+#include <limits>
+#include <string>
 #include <vector>
 #include <algorithm>
 #include "detail/constants.hpp"
@@ -204,6 +207,85 @@ TEST(OrderedSetTests, InsertionTests) {
 	ASSERT_EQ(std::unique(set.begin(), set.end()), set.end());
 }
 
+TEST(OrderedSetTests, RangeInsertionTests) {
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+	set_type set(integers.begin(), integers.end());
+
+	// Test bulk insertion of interleaved values and duplicates into a non-empty container
+	std::vector<int> batch(2 * N);
+	std::generate(batch.begin(), batch.end(), [n = 0]() mutable { return n++; });
+	for (int i = 0; i < N; ++i)
+		batch.emplace_back(i);
+	std::shuffle(batch.begin(), batch.end(), gen);
+	set.insert(batch.begin(), batch.end());
+	ASSERT_EQ(2 * N, set.size());
+	ASSERT_TRUE(std::is_sorted(set.begin(), set.end()));
+	ASSERT_EQ(std::unique(set.begin(), set.end()), set.end());
+
+	// Test bulk insertion past the largest element
+	std::vector<int> tail(N);
+	std::generate(tail.begin(), tail.end(), [n = 2 * N]() mutable { return n++; });
+	set.insert(tail.begin(), tail.end());
+	ASSERT_EQ(3 * N, set.size());
+	ASSERT_TRUE(std::is_sorted(set.begin(), set.end()));
+	ASSERT_EQ(std::unique(set.begin(), set.end()), set.end());
+
+	// Test bulk insertion of values already present
+	set.insert(tail.begin(), tail.end());
+	set.insert({ 0, 1, 2 });
+	ASSERT_EQ(3 * N, set.size());
+}
+
+TEST(OrderedSetTests, SortedInputTests) {
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+
+	// Test construction from a sorted range
+	set_type s1(libra::sorted_unique, integers.begin(), integers.end());
+	ASSERT_EQ(N, s1.size());
+	ASSERT_TRUE(std::equal(s1.begin(), s1.end(), integers.begin(), integers.end()));
+
+	set_type s2(libra::sorted_unique, { 1, 2, 3, 4 });
+	ASSERT_EQ(set_type({ 1, 2, 3, 4 }), s2);
+
+	// Test sorted insertion into a non-empty container
+	std::vector<int> odds(N);
+	std::generate(odds.begin(), odds.end(), [n = 0]() mutable { return 2 * n++ + 1; });
+	s1.insert(libra::sorted_unique, odds.begin(), odds.end());
+	ASSERT_EQ(2 * N, s1.size());
+	ASSERT_TRUE(std::is_sorted(s1.begin(), s1.end()));
+	ASSERT_EQ(std::unique(s1.begin(), s1.end()), s1.end());
+
+	// Test sorted insertion of values already present
+	s1.insert(libra::sorted_unique, { 0, 1, 2, 2 * N });
+	ASSERT_EQ(2 * N + 1, s1.size());
+	ASSERT_TRUE(std::is_sorted(s1.begin(), s1.end()));
+	ASSERT_EQ(std::unique(s1.begin(), s1.end()), s1.end());
+}
+
+TEST(OrderedSetTests, ExtractReplaceTests) {
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+	set_type set(integers.begin(), integers.end());
+
+	// Test that extraction releases the sorted storage
+	auto data = std::move(set).extract();
+	ASSERT_TRUE(set.empty());
+	ASSERT_EQ(N, data.size());
+	ASSERT_TRUE(std::is_sorted(data.begin(), data.end()));
+
+	// Test that replacement adopts the storage without copying
+	const int* address = data.data();
+	set.replace(std::move(data));
+	ASSERT_EQ(N, set.size());
+	ASSERT_EQ(address, &*set.begin());
+	for (int i = 0; i < N; ++i)
+		ASSERT_TRUE(set.contains(i));
+}
+
 TEST(OrderedSetTests, ErasureTests) {
 	set_type set;
 	std::vector<int> integers;
@@ -240,6 +322,173 @@ TEST(OrderedSetTests, LookupTests) {
 	}
 }
 
+TEST(OrderedSetTests, FrozenLookupTests) {
+	// Sizes around one, two and three index levels
+	for (int size : { 0, 1, 16, 17, 255, 256, 257, 4097, 5000 }) {
+		std::vector<int> integers(size);
+		std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+		set_type set(libra::sorted_unique, integers.begin(), integers.end());
+		set.freeze();
+		ASSERT_TRUE(set.frozen());
+		for (int key = -1; key <= 2 * size; ++key) {
+			ASSERT_EQ(std::lower_bound(integers.begin(), integers.end(), key) - integers.begin(), set.lower_bound(key) - set.begin());
+			ASSERT_EQ(std::upper_bound(integers.begin(), integers.end(), key) - integers.begin(), set.upper_bound(key) - set.begin());
+		}
+	}
+
+	// Test that modifications keep the index in sync
+	set_type set;
+	set.freeze();
+	for (int i = 0; i < 20 * N; i += 2)
+		set.insert(i);
+	for (int i = 0; i < 20 * N; i += 4)
+		set.erase(i);
+	for (int i = 0; i < 20 * N; ++i)
+		ASSERT_EQ(i % 4 == 2, set.contains(i));
+	set_type copy(set);
+	ASSERT_TRUE(copy.frozen());
+	ASSERT_TRUE(copy.contains(2));
+	copy.clear();
+	ASSERT_FALSE(copy.contains(2));
+	set.thaw();
+	ASSERT_FALSE(set.frozen());
+	ASSERT_TRUE(set.contains(2));
+
+	// Keys without a vector compare use the scalar node search
+	std::vector<std::string> words;
+	for (int i = 0; i < 20 * N; ++i)
+		words.emplace_back(std::to_string(i));
+	libra::ordered_set<std::string> dictionary(words.begin(), words.end());
+	dictionary.freeze();
+	for (const auto& word : words) {
+		ASSERT_TRUE(dictionary.contains(word));
+		ASSERT_FALSE(dictionary.contains(word + "!"));
+	}
+}
+
+TEST(OrderedSetTests, InterpolationSearchTests) {
+	// Uniform, skewed and clustered key distributions
+	std::vector<std::vector<std::int64_t>> distributions(3);
+	for (std::int64_t i = 0; i < 100 * N; ++i) {
+		distributions[0].emplace_back(1000 * i + i % 7);
+		distributions[1].emplace_back(i * i * i);
+		distributions[2].emplace_back(i < 90 * N ? i : 1000000000 + i);
+	}
+	for (const auto& keys : distributions) {
+		libra::ordered_set<std::int64_t, std::less<std::int64_t>, std::allocator<std::int64_t>, libra::interpolation_search_policy>
+			set(libra::sorted_unique, keys.begin(), keys.end());
+		for (std::size_t i = 0; i < keys.size(); ++i) {
+			for (auto key : { keys[i] - 1, keys[i], keys[i] + 1 }) {
+				ASSERT_EQ(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin(), set.lower_bound(key) - set.begin());
+				ASSERT_EQ(std::upper_bound(keys.begin(), keys.end(), key) - keys.begin(), set.upper_bound(key) - set.begin());
+			}
+		}
+		ASSERT_EQ(set.end(), set.find(keys.back() + 1));
+	}
+
+	libra::ordered_set<double, std::less<>, std::allocator<double>, libra::interpolation_search_policy> reals;
+	for (int i = 0; i < 10 * N; ++i)
+		reals.insert(i * 0.5);
+	for (int i = 0; i < 10 * N; ++i) {
+		ASSERT_TRUE(reals.contains(i * 0.5));
+		ASSERT_FALSE(reals.contains(i * 0.5 + 0.25));
+	}
+
+	// Keys above 2^53 that collapse to one double, and infinite keys
+	std::vector<std::uint64_t> wide;
+	for (std::uint64_t i = 0; i < 2 * N; ++i)
+		wide.emplace_back((std::uint64_t(1) << 61) + 3 * i);
+	libra::ordered_set<std::uint64_t, std::less<std::uint64_t>, std::allocator<std::uint64_t>, libra::interpolation_search_policy>
+		timestamps(libra::sorted_unique, wide.begin(), wide.end());
+	for (std::size_t i = 0; i < wide.size(); ++i) {
+		for (auto key : { wide[i] - 1, wide[i], wide[i] + 1 }) {
+			ASSERT_EQ(std::lower_bound(wide.begin(), wide.end(), key) - wide.begin(), timestamps.lower_bound(key) - timestamps.begin());
+			ASSERT_EQ(std::upper_bound(wide.begin(), wide.end(), key) - wide.begin(), timestamps.upper_bound(key) - timestamps.begin());
+		}
+	}
+
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	reals.insert(-inf);
+	reals.insert(inf);
+	ASSERT_TRUE(reals.contains(-inf));
+	ASSERT_TRUE(reals.contains(inf));
+	for (int i = 0; i < 10 * N; ++i) {
+		ASSERT_TRUE(reals.contains(i * 0.5));
+		ASSERT_FALSE(reals.contains(i * 0.5 + 0.25));
+	}
+	ASSERT_EQ(reals.begin(), reals.lower_bound(-inf));
+	ASSERT_EQ(reals.end(), reals.upper_bound(inf));
+}
+
+TEST(OrderedSetTests, HintedLookupTests) {
+	std::vector<int> integers(20 * N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return 2 * n++; });
+	set_type set(libra::sorted_unique, integers.begin(), integers.end());
+
+	// Nearly ascending queries reuse the previous result as the hint
+	auto hint = set.cbegin();
+	for (int key = -1; key <= 40 * N; ++key) {
+		auto lower = set.lower_bound(hint, key);
+		ASSERT_EQ(set.lower_bound(key), lower);
+		ASSERT_EQ(set.upper_bound(key), set.upper_bound(lower, key));
+		ASSERT_EQ(set.find(key), set.find(hint, key));
+		ASSERT_EQ(set.equal_range(key), set.equal_range(hint, key));
+		hint = lower;
+	}
+
+	// Hints far from the result still find it
+	const auto& cset = set;
+	for (int key : { -1, 0, 7 * N, 20 * N, 40 * N - 2, 40 * N }) {
+		for (auto h : { cset.begin(), cset.begin() + 10 * N, cset.end() }) {
+			ASSERT_EQ(cset.lower_bound(key), cset.lower_bound(h, key));
+			ASSERT_EQ(cset.find(key), cset.find(h, key));
+		}
+	}
+}
+
+TEST(OrderedSetTests, StatsTests) {
+	libra::ordered_set<int, std::less<int>, std::allocator<int>, libra::binary_search_policy, libra::counting_stats> set;
+	set.reserve(4 * N);
+	ASSERT_EQ(1, set.stats().allocations);
+	ASSERT_EQ(4 * N * sizeof(int), set.stats().bytes_allocated);
+	for (int i = 0; i < 4 * N; ++i)
+		set.insert(4 * N - i);
+	ASSERT_EQ(1, set.stats().allocations);
+	ASSERT_LT(0, set.stats().comparisons);
+	// Every insertion lands at the front and shifts the whole tail
+	ASSERT_EQ(4 * N * (4 * N - 1) / 2, set.stats().moves);
+
+	set.stats().reset();
+	ASSERT_TRUE(set.contains(N));
+	ASSERT_FALSE(set.insert(N).second);
+	ASSERT_EQ(0, set.stats().moves);
+	ASSERT_LT(0, set.stats().comparisons);
+
+	set.stats().reset();
+	set.emplace(0);
+	ASSERT_EQ(1, set.stats().rotations);
+	ASSERT_EQ(4 * N + 1, set.stats().rotate_distance);
+	set.erase(set.begin());
+	ASSERT_EQ(4 * N, set.size());
+	ASSERT_TRUE(std::is_sorted(set.begin(), set.end()));
+
+	// A bulk insert reports its reallocation, its sort and its merge
+	set.shrink_to_fit();
+	set.stats().reset();
+	std::vector<int> negatives(N);
+	std::generate(negatives.begin(), negatives.end(), [n = 0]() mutable { return -++n; });
+	set.insert(negatives.begin(), negatives.end());
+	ASSERT_EQ(1, set.stats().allocations);
+	ASSERT_EQ(4 * N + N + 5 * N, set.stats().moves);
+
+	// Stats stay with the container on swap
+	decltype(set) other;
+	set.swap(other);
+	ASSERT_EQ(10 * N, other.size() * 2);
+	ASSERT_EQ(10 * N, set.stats().moves);
+	ASSERT_EQ(0, other.stats().moves);
+}
+
 TEST(OrderedSetTests, LexicographicalTests) {
 	ASSERT_EQ(set_type({ 1, 2, 3, 4 }), set_type({ 1, 2, 3, 4 }));
 	ASSERT_LE(set_type({ 1, 2, 3, 4 }), set_type({ 2, 3, 4, 5 }));
@@ -273,4 +522,41 @@ TEST(OrderedSetTests, TransparentCompareTests) {
 
 	for (auto id : ids)
 		ASSERT_TRUE(set.contains(id));
+}
+
+TEST(OrderedSetTests, MemoryUsageTests) {
+	struct tag {};
+	using tracked_set = libra::ordered_set<int, std::less<int>, libra::tracking_allocator<int, tag>>;
+	using tracker = libra::memory_tracker<tag>;
+	{
+		tracked_set s1;
+		tracked_set s2;
+		ASSERT_EQ(0, s1.allocated_bytes());
+		ASSERT_EQ(0, tracker::live_bytes());
+
+		s1.reserve(2 * N);
+		for (int i = 0; i < N; ++i) {
+			s1.insert(i);
+			s2.insert(-i);
+		}
+		ASSERT_EQ(2 * N * sizeof(int), s1.allocated_bytes());
+		ASSERT_EQ(N * sizeof(int), s1.wasted_capacity());
+		ASSERT_EQ(s1.allocated_bytes() + s2.allocated_bytes(), tracker::live_bytes());
+
+		auto usage = s1.memory_usage() + s2.memory_usage();
+		ASSERT_EQ(tracker::live_bytes(), usage.allocated_bytes);
+		ASSERT_EQ(2 * N * sizeof(int), usage.used_bytes);
+		ASSERT_EQ(0, usage.element_bytes);
+
+		s1.shrink_to_fit();
+		ASSERT_EQ(0, s1.wasted_capacity());
+		ASSERT_LE(s1.allocated_bytes() + s2.allocated_bytes(), tracker::peak_bytes());
+
+		// The frozen index is counted as overhead
+		s1.freeze();
+		ASSERT_LT(N * sizeof(int), s1.allocated_bytes());
+		ASSERT_EQ(s1.allocated_bytes() - N * sizeof(int), s1.wasted_capacity());
+		ASSERT_EQ(s1.allocated_bytes() + s2.allocated_bytes(), tracker::live_bytes());
+	}
+	ASSERT_EQ(0, tracker::live_bytes());
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/pma_ordered_map.hpp"
+#include "detail/constants.hpp"
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using map_type = libra::pma_ordered_map<int, int>;
+using pair_type = std::pair<int, int>;
+
+std::mt19937 gen{ std::random_device{}() };
+
+TEST(PmaOrderedMapTests, ConstructorTests) {
+	map_type m1;
+	ASSERT_TRUE(m1.empty());
+
+	std::vector<pair_type> pairs(N);
+	std::generate(pairs.begin(), pairs.end(), [n = 0]() mutable {
+		auto value = n++;
+		return std::make_pair(value, value);
+	});
+	std::shuffle(pairs.begin(), pairs.end(), gen);
+
+	// Test constructor from external container
+	map_type m2(pairs.begin(), pairs.end());
+	ASSERT_EQ(pairs.size(), m2.size());
+	ASSERT_TRUE(std::is_sorted(m2.begin(), m2.end()));
+
+	// Test construction from a sorted range
+	std::sort(pairs.begin(), pairs.end());
+	map_type m3(libra::sorted_unique, pairs.begin(), pairs.end());
+	ASSERT_EQ(m2, m3);
+
+	// Test copy and move construction
+	map_type copier(m3);
+	ASSERT_EQ(m3, copier);
+	map_type thief(std::move(copier));
+	ASSERT_TRUE(copier.empty());
+	ASSERT_EQ(m3, thief);
+}
+
+TEST(PmaOrderedMapTests, InsertionTests) {
+	map_type map;
+	std::vector<pair_type> expected;
+	std::vector<int> integers(4 * N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+
+	for (auto integer : integers) {
+		auto ret = map.emplace(integer, -integer);
+		ASSERT_TRUE(ret.second);
+		ASSERT_EQ(integer, ret.first->first);
+		ASSERT_EQ(-integer, ret.first->second);
+		ASSERT_FALSE(map.emplace(integer, integer).second);
+		expected.emplace_back(integer, -integer);
+	}
+	std::sort(expected.begin(), expected.end());
+	ASSERT_TRUE(std::equal(expected.begin(), expected.end(), map.begin(), map.end()));
+
+	// Test hinted insertion
+	for (auto integer : integers) {
+		auto it = map.emplace_hint(map.begin(), integer + 4 * N, integer);
+		ASSERT_EQ(integer + 4 * N, it->first);
+	}
+	ASSERT_EQ(8 * N, map.size());
+	ASSERT_TRUE(std::is_sorted(map.begin(), map.end()));
+}
+
+TEST(PmaOrderedMapTests, ElementAccessTests) {
+	map_type map;
+	for (int i = 0; i < N; ++i) {
+		map[i] = i;
+		ASSERT_EQ(i, map.at(i));
+	}
+	for (int i = 0; i < N; ++i) {
+		ASSERT_FALSE(map.insert_or_assign(i, -i).second);
+		ASSERT_FALSE(map.try_emplace(i, i).second);
+		ASSERT_EQ(-i, map[i]);
+	}
+	ASSERT_THROW(map.at(N), std::out_of_range);
+
+	// Test mutation through iterators across segments
+	for (auto& [key, value] : map)
+		value = 2 * key;
+	for (int i = 0; i < N; ++i)
+		ASSERT_EQ(2 * i, map.at(i));
+}
+
+TEST(PmaOrderedMapTests, LookupTests) {
+	map_type map;
+	std::vector<int> integers;
+	for (int i = 1; i <= N; ++i) {
+		integers.emplace_back(i);
+		map.insert(map.end(), map_type::value_type(i, i));
+	}
+	std::shuffle(integers.begin(), integers.end(), gen);
+	for (auto integer : integers) {
+		ASSERT_FALSE(map.contains(-integer));
+		ASSERT_EQ(0, map.count(-integer));
+		ASSERT_TRUE(map.contains(integer));
+		ASSERT_EQ(1, map.count(integer));
+		ASSERT_EQ(integer, map.find(integer)->second);
+		auto range = map.equal_range(integer);
+		ASSERT_EQ(1, std::distance(range.first, range.second));
+	}
+}
+
+TEST(PmaOrderedMapTests, NonTrivialValueTests) {
+	libra::pma_ordered_map<std::string, std::string> map;
+	for (int i = 0; i < N; ++i) {
+		auto key = std::to_string(i * 7 % N);
+		map.emplace(key, std::string(64, 'a' + i % 26) + key);
+		map.emplace_hint(map.begin(), key + "!", key);
+	}
+	ASSERT_EQ(2 * N, map.size());
+	ASSERT_TRUE(std::is_sorted(map.begin(), map.end()));
+	auto copy(map);
+	for (int i = 0; i < N; i += 2)
+		ASSERT_EQ(1, map.erase(std::to_string(i)));
+	ASSERT_EQ(2 * N - N / 2, map.size());
+	ASSERT_EQ(std::to_string(1), map.at(std::to_string(1) + "!"));
+	ASSERT_EQ(2 * N, copy.size());
+}
+
+TEST(PmaOrderedMapTests, SwapTest) {
+	map_type m1({ {1, 1}, {2, 2}, {3, 3} });
+	map_type m2({ {2, 3}, {3, 8}, {4, 3} });
+	m1.swap(m2);
+	ASSERT_EQ(m1, map_type({ {2, 3}, {3, 8}, {4, 3} }));
+	ASSERT_EQ(m2, map_type({ {1, 1}, {2, 2}, {3, 3} }));
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/split_ordered_map.hpp"
+#include "detail/constants.hpp"
+#include <random>
+#include <vector>
+#include <algorithm>
+
+using map_type = libra::split_ordered_map<int, int>;
+using pair_type = std::pair<int, int>;
+
+std::mt19937 gen{ std::random_device{}() };
+
+TEST(SplitOrderedMapTests, ConstructorTests) {
+	map_type m1;
+	ASSERT_TRUE(m1.empty());
+
+	std::vector<pair_type> pairs(N);
+	std::generate(pairs.begin(), pairs.end(), [n = 0]() mutable {
+		auto value = n++;
+		return std::make_pair(value, value);
+	});
+	std::shuffle(pairs.begin(), pairs.end(), gen);
+
+	// Test constructor from external container
+	map_type m2(pairs.begin(), pairs.end());
+	ASSERT_EQ(pairs.size(), m2.size());
+	ASSERT_TRUE(std::is_sorted(m2.keys().begin(), m2.keys().end()));
+	ASSERT_EQ(m2.keys(), m2.values());
+
+	// Tests construction from external container with duplicates
+	auto copy(pairs);
+	for (auto it = copy.begin(); it != copy.end(); ++it)
+		pairs.emplace_back(it->first, -1);
+	std::shuffle(pairs.begin(), pairs.end(), gen);
+
+	map_type m3(pairs.begin(), pairs.end());
+	ASSERT_EQ(N, m3.size());
+	ASSERT_TRUE(std::is_sorted(m3.keys().begin(), m3.keys().end()));
+	ASSERT_EQ(std::adjacent_find(m3.keys().begin(), m3.keys().end()), m3.keys().end());
+
+	// Test construction from a sorted range
+	std::sort(copy.begin(), copy.end());
+	map_type m4(libra::sorted_unique, copy.begin(), copy.end());
+	ASSERT_EQ(m2, m4);
+	ASSERT_EQ(m2.values(), m4.values());
+
+	// Test copy and move construction
+	map_type copier(m4);
+	ASSERT_EQ(m4, copier);
+	map_type thief(std::move(copier));
+	ASSERT_TRUE(copier.empty());
+	ASSERT_EQ(m4, thief);
+}
+
+TEST(SplitOrderedMapTests, IteratorTests) {
+	map_type map({ {3, 30}, {1, 10}, {2, 20} });
+
+	// Test that iterators zip the key and mapped arrays
+	int expected = 1;
+	for (auto it = map.begin(); it != map.end(); ++it, ++expected) {
+		ASSERT_EQ(expected, it->first);
+		ASSERT_EQ(expected * 10, (*it).second);
+	}
+	for (auto [key, value] : map)
+		ASSERT_EQ(key * 10, value);
+
+	// Test mutation through iterators
+	for (auto it = map.begin(); it != map.end(); ++it)
+		it->second = -it->first;
+	ASSERT_EQ(std::vector<int>({ -1, -2, -3 }), map.values());
+
+	// Test random access and reverse iteration
+	map_type::const_iterator cit = map.begin();
+	ASSERT_EQ(3, (cit + 2)->first);
+	ASSERT_EQ(2, cit[1].first);
+	ASSERT_EQ(3, map.end() - cit);
+	ASSERT_EQ(3, map.rbegin()->first);
+	ASSERT_EQ(3, std::distance(map.rbegin(), map.rend()));
+}
+
+TEST(SplitOrderedMapTests, InsertionTests) {
+	map_type map;
+
+	// Test insertion
+	for (int i = 0; i < N; ++i) {
+		auto ret = map.insert(map_type::value_type(i, i));
+		ASSERT_EQ(i, ret.first->first);
+		ASSERT_TRUE(ret.second);
+	}
+	ASSERT_EQ(N, map.size());
+	ASSERT_FALSE(map.insert(map_type::value_type(0, 1)).second);
+	ASSERT_EQ(0, map.at(0));
+
+	map.clear();
+
+	// Test random hint insertion
+	std::srand(std::time(nullptr));
+	std::vector<int> integers(N);
+	std::generate(integers.begin(), integers.end(), [n = 0]() mutable { return n++; });
+	std::shuffle(integers.begin(), integers.end(), gen);
+	auto it = map.begin();
+	for (auto integer : integers) {
+		auto ret = map.insert(it, std::make_pair(integer, integer));
+		ASSERT_EQ(integer, ret->first);
+		it = map.begin() + std::rand() % map.size();
+	}
+	for (auto integer : integers) {
+		auto ret = map.emplace_hint(map.begin() + std::rand() % map.size(), integer, -1);
+		ASSERT_EQ(integer, ret->first);
+		ASSERT_EQ(integer, ret->second);
+	}
+	ASSERT_EQ(N, map.size());
+	ASSERT_TRUE(std::is_sorted(map.keys().begin(), map.keys().end()));
+	ASSERT_EQ(map.keys(), map.values());
+
+	// Test range insertion into a non-empty container
+	std::vector<pair_type> pairs;
+	for (int i = 0; i < 2 * N; ++i)
+		pairs.emplace_back(i, -i);
+	std::shuffle(pairs.begin(), pairs.end(), gen);
+	map.insert(pairs.begin(), pairs.end());
+	ASSERT_EQ(2 * N, map.size());
+	ASSERT_TRUE(std::is_sorted(map.keys().begin(), map.keys().end()));
+	for (int i = 0; i < 2 * N; ++i)
+		ASSERT_EQ(i < N ? i : -i, map.at(i));
+}
+
+TEST(SplitOrderedMapTests, ElementAccessTests) {
+	map_type map;
+	for (int i = 0; i < N; ++i) {
+		map[i] = i;
+		ASSERT_EQ(i, map.at(i));
+	}
+	for (int i = 0; i < N; ++i) {
+		ASSERT_FALSE(map.insert_or_assign(i, -i).second);
+		ASSERT_FALSE(map.try_emplace(i, i).second);
+		ASSERT_EQ(-i, map[i]);
+	}
+	ASSERT_THROW(map.at(N), std::out_of_range);
+}
+
+TEST(SplitOrderedMapTests, ErasureTests) {
+	map_type map;
+	for (int i = 0; i < N; ++i)
+		map.emplace(i, i);
+	for (int i = 0; i < N; i += 2)
+		ASSERT_EQ(1, map.erase(i));
+	ASSERT_EQ(N / 2, map.size());
+	ASSERT_EQ(map.keys(), map.values());
+	while (!map.empty()) {
+		auto it = map.erase(map.begin());
+		ASSERT_EQ(map.begin(), it);
+	}
+	ASSERT_TRUE(map.values().empty());
+}
+
+TEST(SplitOrderedMapTests, LookupTests) {
+	map_type map;
+	std::vector<int> integers;
+	for (int i = 1; i <= N; ++i) {
+		integers.emplace_back(i);
+		map.insert(map.end(), map_type::value_type(i, i));
+	}
+	std::shuffle(integers.begin(), integers.end(), gen);
+	for (auto integer : integers) {
+		ASSERT_FALSE(map.contains(-integer));
+		ASSERT_EQ(0, map.count(-integer));
+		ASSERT_TRUE(map.contains(integer));
+		ASSERT_EQ(1, map.count(integer));
+		ASSERT_EQ(integer, map.find(integer)->second);
+	}
+}
+
+TEST(SplitOrderedMapTests, ExtractReplaceTests) {
+	map_type map({ {3, 30}, {1, 10}, {2, 20} });
+	auto data = std::move(map).extract();
+	ASSERT_TRUE(map.empty());
+	ASSERT_EQ(std::vector<int>({ 1, 2, 3 }), data.keys);
+	ASSERT_EQ(std::vector<int>({ 10, 20, 30 }), data.values);
+
+	map.replace(std::move(data.keys), std::move(data.values));
+	ASSERT_EQ(3, map.size());
+	ASSERT_EQ(20, map.at(2));
+}
+
+TEST(SplitOrderedMapTests, LexicographicalTests) {
+	ASSERT_EQ(map_type({ {1, 1}, {2, 2}, {3, 3} }), map_type({ {1, 1}, {2, 2}, {3, 3} }));
+	ASSERT_LE(map_type({ {1, 1}, {2, 2}, {3, 3} }), map_type({ {2, 3}, {3, 8}, {4, 3} }));
+}
+
+TEST(SplitOrderedMapTests, SwapTest) {
+	map_type m1({ {1, 1}, {2, 2}, {3, 3} });
+	map_type m2({ {2, 3}, {3, 8}, {4, 3} });
+	m1.swap(m2);
+	ASSERT_EQ(m1, map_type({ {2, 3}, {3, 8}, {4, 3} }));
+	ASSERT_EQ(m2, map_type({ {1, 1}, {2, 2}, {3, 3} }));
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "../include/libra/container/split_ordered_multimap.hpp"
+#include "detail/constants.hpp"
+#include <random>
+#include <vector>
+#include <algorithm>
+
+std::mt19937 gen{ std::random_device{}() };
+
+using multimap_type = libra::split_ordered_multimap<int, int>;
+using pair_type = typename multimap_type::value_type;
+
+TEST(SplitOrderedMultimapTests, InsertionTests) {
+	// Setup
+	std::srand(std::time(nullptr));
+	std::vector<pair_type> pairs;
+	for (int i = 0; i < N; ++i) {
+		for (int j = 0; j < N; ++j) {
+			pairs.emplace_back(std::make_pair(i, j));
+		}
+	}
+	multimap_type multimap;
+
+	// Test that single inserts keep equivalent elements in insertion order
+	for (auto pair : pairs) {
+		auto ret = multimap.insert(pair);
+		ASSERT_EQ(pair.first, ret->first);
+		ASSERT_EQ(pair.second, ret->second);
+	}
+	ASSERT_TRUE(std::is_sorted(multimap.keys().begin(), multimap.keys().end()));
+	for (int i = 0; i < N; ++i) {
+		auto range = multimap.equal_range(i);
+		ASSERT_EQ(N, range.second - range.first);
+		for (int j = 0; j < N; ++j)
+			ASSERT_EQ(j, range.first[j].second);
+	}
+
+	multimap.clear();
+
+	// Test random hint insertion
+	auto it = multimap.begin();
+	for (auto pair : pairs) {
+		auto ret = multimap.insert(it, pair);
+		ASSERT_EQ(pair.first, ret->first);
+		it = multimap.begin() + std::rand() % multimap.size();
+	}
+	ASSERT_TRUE(std::is_sorted(multimap.keys().begin(), multimap.keys().end()));
+	for (int i = 0; i < N; ++i)
+		ASSERT_EQ(N, multimap.count(i));
+
+	multimap.clear();
+
+	// Test random range based insert
+	std::shuffle(pairs.begin(), pairs.end(), gen);
+	multimap.insert(pairs.begin(), pairs.end());
+	ASSERT_EQ(pairs.size(), multimap.size());
+	ASSERT_TRUE(std::is_sorted(multimap.keys().begin(), multimap.keys().end()));
+	for (int i = 0; i < N; ++i)
+		ASSERT_EQ(N, multimap.count(i));
+	for (auto pair : pairs) {
+		auto range = multimap.equal_range(pair.first);
+		auto found = std::find_if(range.first, range.second, [&pair](auto ref) { return ref.second == pair.second; });
+		ASSERT_NE(range.second, found);
+	}
+}
+
+TEST(SplitOrderedMultimapTests, ErasureTests) {
+	std::vector<pair_type> pairs;
+	for (int i = 1; i <= N; ++i) {
+		for (int j = 1; j <= N; ++j) {
+			pairs.emplace_back(std::pair(i, j));
+		}
+	}
+	std::shuffle(pairs.begin(), pairs.end(), gen);
+
+	multimap_type multimap(pairs.begin(), pairs.end());
+	for (auto i = 1; i <= N; ++i) {
+		ASSERT_EQ(N, multimap.erase(i));
+	}
+	ASSERT_TRUE(multimap.empty());
+	ASSERT_TRUE(multimap.values().empty());
+}
+
+TEST(SplitOrderedMultimapTests, LexicographicalTests) {
+	ASSERT_EQ(multimap_type({ {0, 0}, {1, 1}, {2, 2} }), multimap_type({ {0, 0}, {1, 1}, {2, 2} }));
+	ASSERT_LE(multimap_type({ {0, 0}, {1, 1}, {2, 2} }), multimap_type({ {1, 2}, {2, 5} }));
+	ASSERT_GE(multimap_type({ {0, 0}, {1, 1}, {2, 2} }), multimap_type({ {0, 0}, {1, 1} }));
+}
\ No newline at end of file